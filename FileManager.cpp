@@ -400,6 +400,40 @@ void FileManager::set_detailed_messages(const bool&  onOff) {
 
 
 
+//--------------------- Obszar wymiany ----------------------
+
+int FileManager::swap_reserve_block() {
+	for (u_int i = 0; i < fileSystem.bitVector.size(); i++) {
+		if (fileSystem.bitVector[i] == BLOCK_FREE) {
+			change_bit_vector_value(i, BLOCK_OCCUPIED);
+			return static_cast<int>(i);
+		}
+	}
+	return -1;
+}
+
+void FileManager::swap_release_block(const u_int& block) {
+	fill(disk.space.begin() + block * BLOCK_SIZE, disk.space.begin() + (block + 1) * BLOCK_SIZE, 0);
+	change_bit_vector_value(block, BLOCK_FREE);
+}
+
+void FileManager::swap_write(const u_int& block, const u_int& offset, const string& data) {
+	disk.write(static_cast<u_short_int>(block * BLOCK_SIZE + offset), data);
+	swapWrites++;
+}
+
+string FileManager::swap_read(const u_int& block, const u_int& offset, const u_int& size, const bool& count) const {
+	if (count) {
+		disk.reads++;
+		swapReads++;
+	}
+	return disk.read_raw(block * BLOCK_SIZE + offset, size);
+}
+
+u_int FileManager::get_block_size() { return BLOCK_SIZE; }
+
+
+
 //------------------ Metody do wywietlania -----------------
 
 void FileManager::display_file_system_params() {
@@ -520,3 +554,9 @@ void FileManager::display_block_char(const unsigned int& block) {
 	}
 	cout << '\n';
 }
+
+void FileManager::display_disk_stats() const {
+	cout << " |  Odczyty blokow : " << disk.reads << " (obszar wymiany: " << swapReads << ")\n";
+	cout << " |   Zapisy blokow : " << disk.writes << " (obszar wymiany: " << swapWrites << ")\n";
+	cout << " |   Wolne miejsce : " << fileSystem.freeSpace << " B\n";
+}
@@ -98,6 +98,10 @@ private:
 		//Tablica reprezentujca przestrze dyskow (jeden indeks - jeden bajt)
 		std::array<char, DISK_CAPACITY> space{};
 
+		//Liczniki operacji dyskowych (odczyty i zapisy blokw)
+		mutable unsigned long long reads = 0;
+		unsigned long long writes = 0;
+
 		//----------------------- Konstruktor -----------------------
 		Disk();
 
@@ -107,6 +111,8 @@ private:
 
 		const std::string read_str(const u_int& begin) const;
 		const std::array<u_int, BLOCK_SIZE / 2> read_arr(const u_int& begin) const;
+		//Odczytuje surowe bajty (razem z zerowymi)
+		const std::string read_raw(const u_int& begin, const u_int& size) const;
 	} disk; //Struktura dysku
 	struct FileSystem {
 		u_int freeSpace{ DISK_CAPACITY }; //Zawiera informacje o iloci wolnego miejsca na dysku (bajty)
@@ -165,6 +171,10 @@ private:
 	bool messages = false; //Zmienna do wczania/wyczania powiadomie
 	bool detailedMessages = false; //Zmienna do wczania/wyczania szczegowych powiadomie
 
+	//Liczniki operacji dyskowych obszaru wymiany (zawieraj si w licznikach dysku)
+	mutable unsigned long long swapReads = 0;
+	unsigned long long swapWrites = 0;
+
 	//Mapa dostpu dla poszczeglnych plikw i procesw
 	//Klucz   - para nazwa pliku, nazwa procesu
 	//Warto - semafor przypisany danemu procesowi
@@ -316,6 +326,54 @@ public:
 
 
 
+	//--------------------- Obszar wymiany ----------------------
+
+	/**
+		Rezerwuje wolny blok dysku na obszar wymiany zarzdcy pamici.\n
+		Blok jest oznaczany w wektorze bitowym jako zajty, wic nie zostanie przydzielony adnemu plikowi.
+
+		@return Numer bloku lub -1, jeli na dysku nie ma wolnego bloku.
+	*/
+	int swap_reserve_block();
+
+	/**
+		Zwalnia blok obszaru wymiany (zawarto bloku jest zerowana).
+
+		@param block Numer bloku.
+		@return void.
+	*/
+	void swap_release_block(const u_int& block);
+
+	/**
+		Zapisuje dane w bloku obszaru wymiany (liczone jako operacja dyskowa).
+
+		@param block Numer bloku.
+		@param offset Przesunicie danych w bloku.
+		@param data Dane do zapisu (musz zmieci si w bloku).
+		@return void.
+	*/
+	void swap_write(const u_int& block, const u_int& offset, const std::string& data);
+
+	/**
+		Odczytuje dane z bloku obszaru wymiany.
+
+		@param block Numer bloku.
+		@param offset Przesunicie danych w bloku.
+		@param size Ilo bajtw do odczytu.
+		@param count Czy odczyt ma by liczony jako operacja dyskowa (false - np. przy wywietlaniu).
+		@return Odczytane dane.
+	*/
+	std::string swap_read(const u_int& block, const u_int& offset, const u_int& size, const bool& count = true) const;
+
+	/**
+		Zwraca rozmiar bloku dysku.
+
+		@return Rozmiar bloku (bajty).
+	*/
+	static u_int get_block_size();
+
+
+
 	//------------------ Metody do wywietlania -----------------
 
 	/**
@@ -363,6 +421,13 @@ public:
 
 	void display_block_char(const unsigned int& block);
 
+	/**
+		Wywietla liczniki operacji dyskowych (wszystkich oraz obszaru wymiany).
+
+		@return void.
+	*/
+	void display_disk_stats() const;
+
 
 
 	//------ KOLEJNE METODY MAO KOGO POWINNY OBCHODZI ---------
@@ -91,6 +91,7 @@ FileManager::Disk::Disk() {
 
 void FileManager::Disk::write(const u_short_int& begin, const string& data) {
 	const u_int end = begin + BLOCK_SIZE - 1;
+	writes++;
 
 	//Indeks ktry bdzie suy do wskazywania na komrki pamici
 	u_int index = begin;
@@ -125,6 +126,7 @@ void FileManager::Disk::write(const u_short_int& begin, const array<u_int, BLOCK
 const string FileManager::Disk::read_str(const u_int& begin) const {
 	string data;
 	const u_int end = begin + BLOCK_SIZE;
+	reads++;
 	//Odczytaj przestrze dyskow od indeksu begin do indeksu end
 	for (u_int index = begin; index < end; index++) {
 		//Dodaj znak zapisany na dysku do danych
@@ -137,6 +139,7 @@ const array<u_int, FileManager::BLOCK_SIZE / 2> FileManager::Disk::read_arr(cons
 	const u_int end = begin + BLOCK_SIZE;		//Odczytywany jest jeden blok
 	array<u_int, BLOCK_SIZE / 2> result{};	//Jedna liczba zajmuje 2 bajty
 	string data;
+	reads++;
 
 	result.fill(-1);
 
@@ -161,6 +164,10 @@ const array<u_int, FileManager::BLOCK_SIZE / 2> FileManager::Disk::read_arr(cons
 	return result;
 }
 
+const string FileManager::Disk::read_raw(const u_int& begin, const u_int& size) const {
+	return string(space.begin() + begin, space.begin() + begin + size);
+}
+
 
 
 //------------------------- File IO -------------------------
@@ -4,6 +4,7 @@
 #include "Processes.h"
 #include "Pipe.h"
 #include <iostream>
+#include <cstring>
 
 using namespace std;
 
@@ -81,17 +82,27 @@ int Interpreter::execute_line(const string& procName) {
 
 	string instructionWhole;
 
-	//Odczyt instrukcji
+	//Odczyt instrukcji (po kawaku do koca biecej stronicy, a do rednika)
 	while (true) {
-		const char cTemp = mm.get_byte(runningProc, instructionCounter)[0];
-		instructionCounter++;
-		if (cTemp != ';') { instructionWhole += cTemp; }
-		else { instructionWhole += ' '; break; }
+		char chunk[16];
+		const size_t chunkSize = 16 - instructionCounter % 16;
+		if (mm.read(runningProc, instructionCounter, chunk, chunkSize, true) == -1) {
+			cout << "Blad odczytu instrukcji! Proces " << runningProc->name << " zostaje zabity!\n";
+			return -1;
+		}
+
+		const char* end = static_cast<const char*>(memchr(chunk, ';', chunkSize));
+		const size_t taken = end != nullptr ? end - chunk : chunkSize;
+		instructionWhole.append(chunk, taken);
+		instructionCounter += taken;
+
+		if (end != nullptr) { instructionWhole += ' '; instructionCounter++; break; }
 	}
 
 
 	//Wykonanie instrukcji (fasz oznacza zakoczenie - HLT)
 	const int result = execute_instruction(instructionWhole, procName);
+	mm.count_instruction(runningProc->PID);
 
 	if (procName != "system_dummy") {
 		if (result != 0) {
@@ -205,7 +216,7 @@ int Interpreter::execute_instruction(const string& instructionWhole, const strin
 		else if (instruction == "DEC") { (*reg1)--; }
 		else if (instruction == "WRITE") {
 			if (address > runningProc->size + strData1.length()) {
-				if (address + strData1.length() > 256) { return -1; }
+				if (address + strData1.length() > mm.page_table(runningProc->pageTable).max_address()) { return -1; }
 				runningProc->resize(address + strData1.length() - 1);
 			}
 
@@ -219,8 +230,9 @@ int Interpreter::execute_instruction(const string& instructionWhole, const strin
 			}
 		}
 		else if (instruction == "GET") {
-			const int tempi = address;
-			*reg2 = mm.get_byte(runningProc, tempi)[0];
+			char byte;
+			if (mm.read(runningProc, address, &byte, 1) == -1) { return -1; }
+			*reg2 = byte;
 		}
 
 
@@ -284,8 +296,8 @@ int Interpreter::execute_instruction(const string& instructionWhole, const strin
 		else if (instruction == "RF") {
 			string temp;
 			if (!instructionParts[3].empty()) {
-				if (address + *reg2 > 256) {
-					const int tooMuch = address + *reg2 - 256;
+				if (address + *reg2 > mm.page_table(runningProc->pageTable).max_address()) {
+					const int tooMuch = address + *reg2 - mm.page_table(runningProc->pageTable).max_address();
 					*reg2 -= tooMuch;
 				}
 				if (address + *reg2 > runningProc->size) {
@@ -317,7 +329,14 @@ int Interpreter::execute_instruction(const string& instructionWhole, const strin
 		//Rozkazy procesy
 
 		//Tworzenie procesu
-		else if (instruction == "CP") { tree.fork(strData1, runningProc->PID, 16); }
+		//Dziecko dostaje kopi obrazu pamici, rejestrw i licznika rozkazw rodzica (fork)
+		else if (instruction == "CP") {
+			if (tree.find(strData1) != nullptr) { cout << "Proces o nazwie \"" << strData1 << "\" juz istnieje!\n"; }
+			else {
+				update_proc(procName);
+				tree.fork(strData1, runningProc->PID);
+			}
+		}
 		//Zabijanie procesu
 		else if (instruction == "DP") { tree.kill(strData1); }
 
@@ -352,8 +371,8 @@ int Interpreter::execute_instruction(const string& instructionWhole, const strin
 			}
 
 			if (address != -1) {
-				if (address + result.length() > 256) {
-					const int tooMuch = address + result.length() - 256;
+				if (address + result.length() > mm.page_table(runningProc->pageTable).max_address()) {
+					const int tooMuch = address + result.length() - mm.page_table(runningProc->pageTable).max_address();
 					result.resize(result.length() - tooMuch);
 				}
 				if (address + result.length() > runningProc->size) {
@@ -395,8 +414,8 @@ int Interpreter::execute_instruction(const string& instructionWhole, const strin
 			}
 
 			if (address != -1) {
-				if (address + result.length() > 256) {
-					const int tooMuch = address + result.length() - 256;
+				if (address + result.length() > mm.page_table(runningProc->pageTable).max_address()) {
+					const int tooMuch = address + result.length() - mm.page_table(runningProc->pageTable).max_address();
 					result.resize(result.length() - tooMuch);
 				}
 				if (address + result.length() > runningProc->size) {
@@ -454,6 +473,26 @@ int Interpreter::execute_instruction(const string& instructionWhole, const strin
 			}
 		}
 
+
+		//Rozkazy pami wspdzielona
+
+		//Utwrz segment pamici wspdzielonej (nazwa, rozmiar w bajtach)
+		else if (instruction == "SHMGET") {
+			if (mm.shm_get(strData1, *reg2) == -1) {
+				cout << "Nie mozna utworzyc segmentu! Proces " << runningProc->name << " zostaje zabity!\n";
+				return -1;
+			}
+		}
+		//Docz segment do pamici procesu (adres pocztku segmentu trafia do rejestru)
+		else if (instruction == "SHMAT") {
+			const int base = mm.shm_attach(runningProc, strData1);
+			if (base == -1) {
+				cout << "Nie mozna dolaczyc segmentu! Proces " << runningProc->name << " zostaje zabity!\n";
+				return -1;
+			}
+			*reg2 = base;
+		}
+
 		//Rozkaz koniec procesu
 		else if (instruction == "HLT") { return -1; }
 		//Rozkaz beczynnoci
@@ -614,6 +653,14 @@ bool Interpreter::simulate_instruction(const string& instructionWhole) {
 		//Wylij wiadomo (do dzieci)
 		else if (instruction == "SMK") {}
 
+
+		//Rozkazy pami wspdzielona
+
+		//Utwrz segment pamici wspdzielonej
+		else if (instruction == "SHMGET") {}
+		//Docz segment do pamici procesu
+		else if (instruction == "SHMAT") {}
+
 		//Rozkaz koniec procesu
 		else if (instruction == "HLT") { return false; }
 		//Rozkaz beczynnoci
@@ -1,19 +1,35 @@
 // Created by Wojciech Kasperski on 15-Oct-18.
 #include "MemoryManager.h"
 #include "Processes.h"
+#include "FileManager.h"
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <climits>
+#include <stdexcept>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
 MemoryManager mm;
 
 //------------- Konstruktory i destruktory  --------------
-MemoryManager::Page::Page(string data) {
-	while (data.length() < 16) { data += " "; } // Uzupełnianie argumentu spacjami, jeśli jest za mały
-	// Przepisywanie argumentu do stronicy
-	for (int i = 0; i < 16; i++) { this->data[i] = data[i]; }
+MemoryManager::Page::Page(string data) : Page(data.data(), min<size_t>(data.length(), 16)) {}
+
+MemoryManager::Page::Page(const char* data, size_t length) {
+	// Przepisywanie fragmentu do stronicy i uzupełnianie spacjami, jeśli jest za mały
+	memcpy(this->data, data, length);
+	memset(this->data + length, ' ', 16 - length);
 }
 
 MemoryManager::Page::Page() : Page("") {}
@@ -25,13 +41,140 @@ PageTableData::PageTableData() {
 	this->frame = -1;
 };
 
-MemoryManager::FrameData::FrameData(bool isFree, int PID, int pageID, vector<PageTableData> *pageList) : isFree(isFree), PID(PID), pageID(pageID), pageList(pageList) {}
+//------------- Wielopoziomowa tablica stronic  --------------
+int PageTable::defaultLevels = 1;
+
+PageTable::PageTable(int levels) : depth(levels), Nodes(1) {}
+
+void PageTable::reset(int levels) {
+	depth = levels;
+	pages = 0;
+	Nodes.resize(1);
+	Nodes[0].children.clear();
+	Nodes[0].entries.clear();
+}
+
+PageTable::Node* PageTable::leaf(int pageID, bool create) {
+	if (depth == 1) { return &Nodes[0]; }
+
+	//Węzły wskazywane są indeksami, bo dodanie węzła może przenieść wektor Nodes
+	int node = 0;
+	for (int level = depth; level > 1; level--) {
+		//Korzeń tablicy 3-poziomowej rośnie razem z najwyższą używaną stronicą (najwyżej 8192 wpisy dla 31-bitowych adresów)
+		//Korzeń tablicy 2-poziomowej ma stałą wielkość jak węzeł pośredni - resize nie dopuszcza większych przestrzeni adresowych
+		const int shift = LEAF_BITS + NODE_BITS * (level - 2);
+		size_t index = static_cast<size_t>(pageID) >> shift;
+		if (level != depth) { index &= (1 << NODE_BITS) - 1; }
+
+		if (index >= Nodes[node].children.size()) {
+			if (!create) { return nullptr; }
+			if (level == depth && depth == 2 && index >= size_t(1) << NODE_BITS) { return nullptr; }
+			Nodes[node].children.resize(level == depth && depth == 3 ? index + 1 : size_t(1) << NODE_BITS, -1);
+		}
+		if (Nodes[node].children[index] == -1) {
+			if (!create) { return nullptr; }
+			const int child = static_cast<int>(Nodes.size());
+			Nodes.emplace_back();
+			Nodes[node].children[index] = child;
+			//Nowy liść zawiera same stronice na żądanie
+			if (level == 2) {
+				PageTableData blank(false, 0);
+				blank.zero = true;
+				Nodes[child].entries.assign(size_t(1) << LEAF_BITS, blank);
+			}
+		}
+		node = Nodes[node].children[index];
+	}
+	return &Nodes[node];
+}
+
+const PageTable::Node* PageTable::leaf(int pageID) const {
+	return const_cast<PageTable*>(this)->leaf(pageID, false);
+}
+
+size_t PageTable::size() const { return pages; }
+
+bool PageTable::resize(size_t size) {
+	//Tablica nie obejmuje stronic powyżej max_address (ograniczona wielkość korzenia)
+	if (size > max_address() / 16) { return false; }
+	if (size <= pages) { return true; }
+	if (depth == 1) {
+		PageTableData blank(false, 0);
+		blank.zero = true;
+		Nodes[0].entries.resize(size, blank);
+	}
+	pages = size;
+	return true;
+}
+
+PageTableData& PageTable::at(int pageID) {
+	const int index = depth == 1 ? pageID : pageID & ((1 << LEAF_BITS) - 1);
+	Node* node = leaf(pageID, true);
+	//Stronica spoza przestrzeni adresowej tablicy (jak std::vector::at)
+	if (node == nullptr || (depth == 1 && static_cast<size_t>(index) >= node->entries.size())) {
+		throw out_of_range("PageTable::at - stronica " + to_string(pageID) + " poza przestrzenia adresowa");
+	}
+	return node->entries[index];
+}
+
+PageTableData& PageTable::operator[](int pageID) { return at(pageID); }
+
+const PageTableData* PageTable::find(int pageID) const {
+	const Node* node = leaf(pageID);
+	if (node == nullptr) { return nullptr; }
+	return &node->entries[depth == 1 ? pageID : pageID & ((1 << LEAF_BITS) - 1)];
+}
+
+void PageTable::for_each(const function<void(int, PageTableData&)>& visit) {
+	//Przejście w głąb drzewa - first to numer pierwszej stronicy obejmowanej przez węzeł
+	function<void(int, int, int)> walk = [&](int node, int level, int first) {
+		if (level == 1) {
+			for (size_t i = 0; i < Nodes[node].entries.size() && first + i < pages; i++) { visit(first + static_cast<int>(i), Nodes[node].entries[i]); }
+			return;
+		}
+		const int shift = LEAF_BITS + NODE_BITS * (level - 2);
+		for (size_t i = 0; i < Nodes[node].children.size(); i++) {
+			if (Nodes[node].children[i] != -1) { walk(Nodes[node].children[i], level - 1, first + (static_cast<int>(i) << shift)); }
+		}
+	};
+	walk(0, depth, 0);
+}
+
+void PageTable::for_each(const function<void(int, const PageTableData&)>& visit) const {
+	const_cast<PageTable*>(this)->for_each([&](int pageID, PageTableData& entry) { visit(pageID, entry); });
+}
+
+int PageTable::levels() const { return depth; }
 
-MemoryManager::MemoryManager() : RAM{} {
-	for (int i = 0; i < 16; i++) { Frames.emplace_back(FrameData(true, -1, -1, nullptr)); }
+unsigned int PageTable::max_address() const { return address_limit(depth); }
+
+unsigned int PageTable::address_limit(int levels) {
+	if (levels == 1) { return 256; }
+	if (levels == 2) { return (1u << (LEAF_BITS + NODE_BITS)) * 16; }
+	return static_cast<unsigned int>(INT_MAX);
+}
+
+size_t PageTable::nodes() const { return Nodes.size(); }
+
+size_t PageTable::bytes() const {
+	size_t total = sizeof(PageTable) + Nodes.capacity() * sizeof(Node);
+	for (const Node& node : Nodes) {
+		total += node.entries.capacity() * sizeof(PageTableData) + node.children.capacity() * sizeof(int);
+	}
+	return total;
+}
+
+MemoryManager::MemoryManager(int frameCount) : RAM(frameCount * 16, ' ') {
+	for (int i = 0; i < frameCount; i++) {
+		Frames.emplace_back(FrameData());
+		Frames[i].stackPosition = Stack.insert(Stack.end(), i);
+		FreeFrames.insert(FreeFrames.end(), i);
+	}
 };
 
-MemoryManager::~MemoryManager() = default;
+MemoryManager::~MemoryManager() { set_trace(""); }
+
+MemoryManager::TLB::TLB() { configure(8, 2, false); }
 
 //------------- Funkcje do wyświetlania bieżących stanów pamięci oraz pracy krokowej  --------------
 void MemoryManager::Page::print() const {
@@ -39,24 +182,21 @@ void MemoryManager::Page::print() const {
 		if (x == ' ') cout << "_";
 		else cout << x;
 	}
-	cout << '\n';
 }
 
 void MemoryManager::show_memory() {
 	cout << "RAM - PHYSICAL FRAMES CONTENT: \n";
 	cout << "First bit: 0 ->\t0123456789012345 -> 15 :last bit in frame\n";
-	for (int i = 0; i < 256; i++) {
-		if (i % 16 == 0 && i != 0) { cout << "\nFrame no." << i / 16 << ": \t"; }
-		else if (i % 16 == 0) { cout << "Frame no." << i / 16 << ": \t"; }
-		if (RAM[i] == ' ' || RAM[i] == '\0') { cout << '_'; }
-		else if (RAM[i] == '\n' || RAM[i] == '\r') { cout << '_'; }
-		else { cout << RAM[i]; }
+	for (size_t i = 0; i < Frames.size(); i++) {
+		if (i != 0) { cout << '\n'; }
+		print_frame(static_cast<int>(i));
 	}
 	cout << endl;
+	shownGeneration = memoryGeneration++;
 }
 
 void MemoryManager::show_memory(int begin, int bytes) {
-	if (begin + bytes > 256) {
+	if (begin < 0 || begin + bytes > static_cast<int>(RAM.size())) {
 		cout << "Error: Number of bytes to display has excced amount of memory! \n";
 	}
 	else {
@@ -69,25 +209,108 @@ void MemoryManager::show_memory(int begin, int bytes) {
 	}
 }
 
+void MemoryManager::show_memory_diff() {
+	cout << "RAM - FRAMES CHANGED SINCE LAST VIEW: \n";
+	int changed = 0;
+	for (size_t i = 0; i < Frames.size(); i++) {
+		if (Frames[i].generation <= shownGeneration) continue;
+		print_frame(static_cast<int>(i));
+		cout << '\n';
+		changed++;
+	}
+	if (changed == 0) { cout << "No changes\n"; }
+	else { cout << changed << " of " << Frames.size() << " frames changed\n"; }
+	shownGeneration = memoryGeneration++;
+}
+
+void MemoryManager::print_frame(int frame) const {
+	//Cała ramka trafia do strumienia jednym zapisem zamiast znak po znaku
+	char line[16];
+	for (int i = 0; i < 16; i++) {
+		const char byte = RAM[frame * 16 + i];
+		line[i] = byte == ' ' || byte == '\0' || byte == '\n' || byte == '\r' ? '_' : byte;
+	}
+	cout << "Frame no." << frame << ": \t";
+	cout.write(line, 16);
+}
+
+void MemoryManager::show_heatmap() const {
+	static const char scale[] = ".:-=+*%#";
+	unsigned long long hottest = 0, total = 0;
+	for (const FrameData& frame : Frames) {
+		hottest = max(hottest, frame.accesses);
+		total += frame.accesses;
+	}
+
+	cout << "FRAME HEATMAP (" << total << " accesses, hottest frame: " << hottest << "): \n";
+	string row;
+	for (size_t i = 0; i < Frames.size(); i++) {
+		//Temperatura ramki względem najczęściej używanej ramki, '.' - ramka nieużywana
+		int level = 0;
+		if (Frames[i].accesses > 0) { level = 1 + static_cast<int>(Frames[i].accesses * 6 / hottest); }
+		row += scale[level];
+		if (i % 16 == 15 || i + 1 == Frames.size()) {
+			cout << "Frames " << setfill(' ') << setw(4) << i - i % 16 << "-" << setw(4) << i << ": " << row << "\n";
+			row.clear();
+		}
+	}
+	cout << "Scale: " << scale << " (unused -> hottest)\n";
+
+	cout << "FRAME\tACCESSES\tPID\tPAGE\n";
+	for (size_t i = 0; i < Frames.size(); i++) {
+		if (Frames[i].accesses == 0) continue;
+		cout << i << "\t" << Frames[i].accesses << "\t\t";
+		if (Frames[i].owners == -1) { cout << "-\t-\n"; }
+		else { cout << Owners[Frames[i].owners].PID << "\t" << Owners[Frames[i].owners].pageID << "\n"; }
+	}
+}
+
+void MemoryManager::reset_heatmap() {
+	for (FrameData& frame : Frames) { frame.accesses = 0; }
+}
+
 void MemoryManager::show_page_file() const {
 	cout << "-------Page File-------\n";
-	for (const auto& process : PageFile) {
+	for (const auto& process : PageTables) {
 		cout << "\n**** PID:" << process.first << " ****\n";
 		//cout << "Pages Content:";\n
-		for (unsigned int i = 0; i < process.second.size(); i++) {
+		//Wyświetlane są tylko stronice z istniejących węzłów tablicy (reszta to stronice na żądanie)
+		PageTableArena[process.second].for_each([&](int i, const PageTableData& entry) {
 			cout << setfill('0') << setw(2) << i << ". ";
-			process.second[i].print();
-		}
+			if (entry.slot == -1) {
+				cout << "________________\t(demand-zero)\n";
+				return;
+			}
+			Page page;
+			peek_slot(entry.slot, page.data);
+			page.print();
+			const int references = PageSlots[entry.slot].references;
+			if (references > 1) { cout << "\t(shared x" << references << ")"; }
+			cout << '\n';
+		});
 	}
 }
 
-void MemoryManager::show_page_table(const shared_ptr<vector<PageTableData>>& pageList)
+void MemoryManager::show_page_table(int table) const
 {
-	cout << "PAGE\t | \tFRAME \t | \tBIT \n";
-	int i = 0;
-	for (const auto pageListRecord : *pageList) {
-		cout << i++ << "\t\t" << pageListRecord.frame << "\t\t" << pageListRecord.bit << "\n";
+	const PageTable& pageList = page_table(table);
+	if (pageList.levels() > 1) {
+		cout << "Levels: " << pageList.levels() << ", Pages: " << pageList.size() << ", Nodes: " << pageList.nodes()
+			<< ", Size: " << pageList.bytes() << "B\n";
+	}
+	cout << "PAGE\t | \tFRAME \t | \tBIT \t | \tCOW \n";
+	pageList.for_each([](int i, const PageTableData& pageListRecord) {
+		cout << i << "\t\t" << pageListRecord.frame << "\t\t" << pageListRecord.bit << "\t\t" << pageListRecord.cow << "\n";
+	});
+}
+
+int MemoryManager::set_page_table_levels(int levels) {
+	if (levels < 1 || levels > 3) {
+		cout << "Error: Page table must have 1, 2 or 3 levels!\n";
+		return -1;
 	}
+	PageTable::defaultLevels = levels;
+	return 1;
 }
 
 void MemoryManager::show_stack() {
@@ -100,218 +323,1426 @@ void MemoryManager::show_stack() {
 
 void MemoryManager::show_frames() {
 	cout << "FRAMES INFO: \n";
-	cout << "\t\tFREE \tPAGE \tPID " << endl;
+	cout << "\t\tFREE \tPAGE \tPID \tSHARED" << endl;
 	int i = 0;
 	for (auto &frame : Frames) {
-		cout << "Frame no." << i++ << ":\t" << frame.isFree << "\t" << frame.pageID << "\t" << frame.PID << "\n";
+		cout << "Frame no." << i++ << ":\t" << frame.isFree << "\t";
+		if (frame.owners == -1) { cout << -1 << "\t" << -1 << "\t" << 0 << "\n"; }
+		else { cout << Owners[frame.owners].pageID << "\t" << Owners[frame.owners].PID << "\t" << frame.ownerCount << "\n"; }
 	}
 }
 
-//------------- Funkcje użytkowe MemoryManagera  --------------
-void MemoryManager::memory_init() {
-	for (char &cell : RAM) { cell = ' '; }
-	PageFile.emplace(pair(1, vector<Page>{ Page("JMP [0];") }));
+void MemoryManager::show_tlb() const {
+	tlb.print();
 }
 
-void MemoryManager::stack_update(int frameID) {
-	if (frameID > 15) return;
+int MemoryManager::set_tlb(int size, int ways, bool tagged) {
+	return tlb.configure(size, ways, tagged);
+}
+
+void MemoryManager::TLB::print() const {
+	cout << "TLB: " << entries.size() << " entries, " << ways << "-way, " << (tagged ? "ASID tagged" : "flush on context switch") << "\n";
+	cout << "SET\tWAY\tPID\tPAGE\tFRAME\n";
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (!entries[i].valid) continue;
+		cout << i / ways << "\t" << i % ways << "\t" << entries[i].PID << "\t" << entries[i].pageID << "\t" << entries[i].frame << "\n";
+	}
+	const unsigned long long lookups = hits + misses;
+	cout << "Hits: " << hits << "\tMisses: " << misses << "\tFlushes: " << flushes;
+	if (lookups != 0) { cout << "\tHit ratio: " << fixed << setprecision(2) << 100.0 * hits / lookups << "%"; }
+	cout << endl;
+}
+
+void MemoryManager::show_segments() const {
+	cout << "SHARED MEMORY SEGMENTS: \n";
+	cout << "NAME\tSIZE\tPID\n";
+	for (const auto& segment : Segments) {
+		cout << segment.first << "\t" << segment.second.slots.size() * 16 << "\t";
+		for (const int PID : segment.second.attached) { cout << PID << " "; }
+		cout << "\n";
+	}
+}
+
+void MemoryManager::show_swap_file() const {
+	cout << "Page file: " << PageSlots.size() << " slots (" << FreeSlots.size() << " free), stored in ";
+	if (swapFile.is_open()) { cout << "mapped file \"" << swapFile.name() << "\" (" << swapFile.size() * 16 << " bytes)\n"; }
+	else { cout << "memory\n"; }
+}
+
+int MemoryManager::set_swap_file(const string& path) {
+	//Powrót do pliku stronicowania w pamięci (plik na dysku zostaje do przejrzenia)
+	if (path.empty()) {
+		if (!swapFile.is_open()) { return 1; }
+		SlotMemory.assign(swapFile.slot(0), swapFile.slot(0) + PageSlots.size() * 16);
+		swapFile.close();
+		return 1;
+	}
+
+	if (swapFile.is_open()) {
+		cout << "Error: Swap file \"" << swapFile.name() << "\" is already in use!\n";
+		return -1;
+	}
+	if (compressedSwap) {
+		cout << "Error: Swap file cannot be used with compressed page file!\n";
+		return -1;
+	}
+	if (!swapFile.open(path, PageSlots.size())) {
+		cout << "Error: Cannot create or map swap file \"" << path << "\"!\n";
+		return -1;
+	}
+
+	//Przepisanie dotychczasowych slotów do pliku
+	if (!SlotMemory.empty()) { memcpy(swapFile.slot(0), SlotMemory.data(), SlotMemory.size()); }
+	SlotMemory.clear();
+	SlotMemory.shrink_to_fit();
+	return 1;
+}
+
+void MemoryManager::show_trace() const {
+	if (!traceFile.is_open()) {
+		cout << "Memory trace: off\n";
+		return;
+	}
+	cout << "Memory trace: \"" << tracePath << "\", " << traceRecords << " accesses (" << TraceBuffer.size() << " buffered)\n";
+}
+
+int MemoryManager::set_trace(const string& path) {
+	//Zakończenie zapisu - rekordy z bufora trafiają do pliku
+	if (path.empty()) {
+		if (!traceFile.is_open()) { return 1; }
+		flush_trace();
+		traceFile.close();
+		return 1;
+	}
+
+	if (traceFile.is_open()) {
+		cout << "Error: Memory trace \"" << tracePath << "\" is already being recorded!\n";
+		return -1;
+	}
+	traceFile.open(path, ios::binary | ios::trunc);
+	if (!traceFile.is_open()) {
+		cout << "Error: Cannot create trace file \"" << path << "\"!\n";
+		return -1;
+	}
+
+	const uint32_t header[4] = { 0x52545853, 1, static_cast<uint32_t>(Frames.size()), 16 }; //"SXTR"
+	traceFile.write(reinterpret_cast<const char*>(header), sizeof(header));
+	tracePath = path;
+	traceRecords = 0;
+	TraceBuffer.reserve(TRACE_BUFFER);
+	return 1;
+}
+
+void MemoryManager::trace_access(int PID, int pageID, bool write) {
+	if (!traceFile.is_open()) { return; }
+	TraceBuffer.push_back(TraceRecord{ static_cast<uint32_t>(PID), static_cast<uint32_t>(pageID) << 1 | (write ? 1u : 0u) });
+	traceRecords++;
+	if (TraceBuffer.size() >= TRACE_BUFFER) { flush_trace(); }
+}
+
+void MemoryManager::flush_trace() {
+	if (TraceBuffer.empty()) { return; }
+	traceFile.write(reinterpret_cast<const char*>(TraceBuffer.data()), TraceBuffer.size() * sizeof(TraceRecord));
+	traceFile.flush();
+	TraceBuffer.clear();
+}
+
+void MemoryManager::show_disk_swap() const {
+	int pages = 0;
+	for (const auto& page : PageSlots) {
+		if (page.disk != -1) pages++;
+	}
+	cout << "Disk swap: " << (diskSwap ? "on" : "off") << ", blocks: " << SwapBlocks.size() << "/" << diskSwapLimit
+		<< ", pages on disk: " << pages << " (" << FreeDiskSlots.size() << " free)\n";
+	cout << "Page-outs: " << DiskSwap.pageOuts << ", page-ins: " << DiskSwap.pageIns << ", overflows: " << DiskSwap.overflows << "\n";
+	fm.display_disk_stats();
+}
+
+int MemoryManager::set_disk_swap(bool enable, int blocks) {
+	if (blocks <= 0) {
+		cout << "Error: Swap area must have at least one block!\n";
+		return -1;
+	}
+	if (enable && compressedSwap) {
+		cout << "Error: Disk swap cannot be used with compressed page file!\n";
+		return -1;
+	}
+	diskSwap = enable;
+	diskSwapLimit = blocks;
+	if (enable) { return 1; }
+
+	//Stronice z dysku wracają do pliku stronicowania, a bloki do systemu plików
+	for (size_t i = 0; i < PageSlots.size(); i++) {
+		if (PageSlots[i].disk == -1) continue;
+		Page page;
+		peek_slot(static_cast<int>(i), page.data);
+		PageSlots[i].disk = -1;
+		store_slot(static_cast<int>(i), page.data);
+	}
+	for (const unsigned int block : SwapBlocks) { fm.swap_release_block(block); }
+	SwapBlocks.clear();
+	FreeDiskSlots.clear();
+	return 1;
+}
+
+void MemoryManager::show_compression() const {
+	if (!compressedSwap) {
+		cout << "Page file compression: off\n";
+		return;
+	}
+
+	int pages = 0, sameFilled = 0, raw = 0;
+	for (const auto& page : PageSlots) {
+		if (page.references == 0) continue;
+		pages++;
+		if (page.length == 0) sameFilled++;
+		else if (page.length == 16) raw++;
+	}
+	const size_t stored = CompressedPool.size() - poolGarbage;
+
+	cout << "Page file compression: on\n";
+	cout << "Pages: " << pages << "\tSame-filled: " << sameFilled << "\tUncompressed: " << raw << "\n";
+	cout << "Original: " << pages * 16 << " B\tCompressed: " << stored << " B\tPool: " << CompressedPool.size() << " B (" << poolGarbage << " B stale)\n";
+	if (stored != 0) { cout << "Ratio: " << fixed << setprecision(2) << static_cast<double>(pages * 16) / stored << ":1\n"; }
+	else { cout << "Ratio: -\n"; }
+	if (Compression.compressions != 0) { cout << "Compress: " << Compression.compressions << " pages, avg " << Compression.compressNs / Compression.compressions << " ns\n"; }
+	if (Compression.decompressions != 0) { cout << "Decompress: " << Compression.decompressions << " pages, avg " << Compression.decompressNs / Compression.decompressions << " ns\n"; }
+}
+
+int MemoryManager::set_compression(bool enable) {
+	if (enable == compressedSwap) { return 1; }
+	if (swapFile.is_open()) {
+		cout << "Error: Compressed page file cannot be used with swap file!\n";
+		return -1;
+	}
+	if (diskSwap || !SwapBlocks.empty()) {
+		cout << "Error: Compressed page file cannot be used with disk swap!\n";
+		return -1;
+	}
 
-	for (auto it = Stack.begin(); it != Stack.end(); ++it) {
-		if (*it == frameID) {
-			Stack.erase(it);
-			break;
+	if (enable) {
+		//Kompresja wszystkich dotychczasowych slotów do puli
+		compressedSwap = true;
+		CompressedPool.clear();
+		poolGarbage = 0;
+		for (size_t i = 0; i < PageSlots.size(); i++) {
+			PageSlots[i].length = 0;
+			store_slot(static_cast<int>(i), &SlotMemory[i * 16]);
 		}
+		SlotMemory.clear();
+		SlotMemory.shrink_to_fit();
+	}
+	else {
+		//Rozpakowanie slotów z powrotem do pamięci
+		SlotMemory.resize(PageSlots.size() * 16);
+		for (size_t i = 0; i < PageSlots.size(); i++) { load_slot(static_cast<int>(i), &SlotMemory[i * 16]); }
+		compressedSwap = false;
+		CompressedPool.clear();
+		CompressedPool.shrink_to_fit();
+		poolGarbage = 0;
+	}
+	return 1;
+}
+
+void MemoryManager::show_prefetch() const {
+	const int reserve = prefetchReserve == -1 ? static_cast<int>(Frames.size()) / 4 : prefetchReserve;
+	cout << "Read-ahead: " << (prefetchMax == 0 ? "off" : "up to " + to_string(prefetchMax) + " pages") << ", reserved free frames: " << reserve << "\n";
+	cout << "PID\tPREF\tHITS\tMISSES\tWINDOW\n";
+	cout << "all\t" << GlobalStats.prefetches << "\t" << GlobalStats.prefetchHits << "\t" << GlobalStats.prefetchMisses << "\t-\n";
+	for (const auto& stats : ProcessStats) {
+		const auto state = Prefetch.find(stats.first);
+		cout << stats.first << "\t" << stats.second.prefetches << "\t" << stats.second.prefetchHits << "\t" << stats.second.prefetchMisses << "\t"
+			<< (state == Prefetch.end() ? 0 : state->second.window) << "\n";
 	}
+}
 
-	//Stack.push_front(frameID);
-	Stack.push_back(frameID);
+int MemoryManager::set_prefetch(int maxPages, int reserve) {
+	if (maxPages < 0 || reserve < 0 || reserve > static_cast<int>(Frames.size())) {
+		cout << "Error: Invalid read-ahead configuration!\n";
+		return -1;
+	}
+	prefetchMax = maxPages;
+	prefetchReserve = reserve;
+	return 1;
 }
 
-shared_ptr<vector<PageTableData>> MemoryManager::create_page_list(int mem, int PID) {
-	const double pages = ceil(static_cast<double>(mem) / 16);
-	shared_ptr<vector<PageTableData>> pageList = make_shared<vector<PageTableData>>();
+void MemoryManager::show_stats() const {
+	cout << "PAGING STATISTICS (fault rate over last " << PagingStats::WINDOW << " instructions)\n";
+	cout << "PID\tFAULTS\tEVICT\tWBACK\tZFILL\tCOW\tRSS\tRATE\n";
+	cout << "all\t";
+	GlobalStats.print();
+	for (const auto& stats : ProcessStats) {
+		cout << stats.first << "\t";
+		stats.second.print();
+	}
+}
+
+void MemoryManager::show_stats(int PID) const {
+	const auto stats = ProcessStats.find(PID);
+	if (stats == ProcessStats.end()) {
+		cout << "Error: No paging statistics for PID " << PID << "!\n";
+		return;
+	}
+	cout << "PID\tFAULTS\tEVICT\tWBACK\tZFILL\tCOW\tRSS\tRATE\n";
+	cout << PID << "\t";
+	stats->second.print();
+}
+
+void MemoryManager::show_frame_quotas() const {
+	cout << "Replacement: " << (localReplacement ? "local" : "global") << ", frames: " << Frames.size() << ", free: " << FreeFrames.size() << "\n";
+	cout << "PID\tMIN\tMAX\tRSS\tFAULTS\tEVICT\tRATE\n";
+	for (const auto& stats : ProcessStats) {
+		const auto quota = Quotas.find(stats.first);
+		const FrameQuota limits = quota == Quotas.end() ? FrameQuota() : quota->second;
+		cout << stats.first << "\t" << limits.min << "\t";
+		if (limits.max > 0) { cout << limits.max; }
+		else { cout << "-"; }
+		cout << "\t" << stats.second.resident << "\t" << stats.second.faults << "\t" << stats.second.evictions << "\t"
+			<< fixed << setprecision(3) << stats.second.fault_rate() << "\n";
+	}
+}
 
-	for (int i = 0; i < pages; i++) {
-		pageList->push_back(PageTableData(false, 0));
+int MemoryManager::set_frame_quota(int PID, int minFrames, int maxFrames) {
+	if (minFrames < 0 || maxFrames < 0 || (maxFrames > 0 && maxFrames < max(minFrames, 1))) {
+		cout << "Error: Invalid frame quota (0 <= min <= max, max = 0 means no limit)!\n";
+		return -1;
+	}
+
+	//Gwarantowane ramki wszystkich procesów muszą zostawić przynajmniej jedną ramkę do wymiany
+	int reserved = minFrames;
+	for (const auto& quota : Quotas) {
+		if (quota.first != PID) { reserved += quota.second.min; }
 	}
+	if (reserved >= static_cast<int>(Frames.size())) {
+		cout << "Error: Guaranteed frames of all processes must be less than " << Frames.size() << "!\n";
+		return -1;
+	}
+
+	if (minFrames == 0 && maxFrames == 0) { Quotas.erase(PID); }
+	else { Quotas[PID] = FrameQuota{ minFrames, maxFrames }; }
+	return 1;
+}
+
+void MemoryManager::set_local_replacement(bool local) { localReplacement = local; }
+
+bool MemoryManager::get_local_replacement() const { return localReplacement; }
+
+void MemoryManager::PagingStats::print() const {
+	cout << faults << "\t" << evictions << "\t" << writeBacks << "\t" << zeroFills << "\t" << copies << "\t" << resident << "\t"
+		<< fixed << setprecision(3) << fault_rate() << "\n";
+}
+
+//------------- Statystyki stronicowania  --------------
+void MemoryManager::PagingStats::instruction() {
+	//Pełne okno - nowy wpis zastępuje najstarszy
+	if (windowCount == WINDOW) { windowFaults -= window[windowHead]; }
+	else { windowCount++; }
+	window[windowHead] = pendingFaults;
+	windowFaults += pendingFaults;
+	pendingFaults = 0;
+	windowHead = (windowHead + 1) % WINDOW;
+}
+
+double MemoryManager::PagingStats::fault_rate() const {
+	if (windowCount == 0) return 0.0;
+	return static_cast<double>(windowFaults) / windowCount;
+}
+
+void MemoryManager::count_instruction(int PID) {
+	GlobalStats.instruction();
+	ProcessStats[PID].instruction();
+}
+
+double MemoryManager::fault_rate() const { return GlobalStats.fault_rate(); }
+
+int MemoryManager::free_frames() const { return static_cast<int>(FreeFrames.size()); }
+
+//------------- Bufor TLB  --------------
+int MemoryManager::TLB::configure(int size, int ways, bool tagged) {
+	if (size <= 0 || ways <= 0 || size % ways != 0) {
+		cout << "Error: Invalid TLB configuration (size must be a multiple of ways)!\n";
+		return -1;
+	}
+
+	this->entries.assign(size, Entry());
+	this->ways = ways;
+	this->sets = size / ways;
+	this->tagged = tagged;
+	this->currentPID = -1;
+	hits = misses = flushes = 0;
+	return 1;
+}
+
+void MemoryManager::TLB::switch_to(int PID) {
+	if (PID == currentPID) return;
+	currentPID = PID;
+	if (!tagged) { flush(); }
+}
+
+int MemoryManager::TLB::lookup(int PID, int pageID) {
+	const int set = pageID % sets;
+	for (int i = set * ways; i < set * ways + ways; i++) {
+		if (entries[i].valid && entries[i].pageID == pageID && entries[i].PID == PID) {
+			entries[i].lastUse = ++clock;
+			hits++;
+			return entries[i].frame;
+		}
+	}
+	misses++;
+	return -1;
+}
+
+void MemoryManager::TLB::insert(int PID, int pageID, int frame) {
+	const int set = pageID % sets;
+
+	//Wybór ofiary - wolny wpis albo najdawniej używany w zbiorze
+	int victim = set * ways;
+	for (int i = set * ways; i < set * ways + ways; i++) {
+		if (!entries[i].valid) { victim = i; break; }
+		if (entries[i].lastUse < entries[victim].lastUse) { victim = i; }
+	}
+
+	entries[victim].valid = true;
+	entries[victim].PID = PID;
+	entries[victim].pageID = pageID;
+	entries[victim].frame = frame;
+	entries[victim].lastUse = ++clock;
+}
+
+void MemoryManager::TLB::invalidate_frame(int frame) {
+	for (auto& entry : entries) {
+		if (entry.frame == frame) { entry.valid = false; }
+	}
+}
+
+void MemoryManager::TLB::invalidate_page(int PID, int pageID) {
+	for (auto& entry : entries) {
+		if (entry.PID == PID && entry.pageID == pageID) { entry.valid = false; }
+	}
+}
+
+void MemoryManager::TLB::invalidate_process(int PID) {
+	for (auto& entry : entries) {
+		if (entry.PID == PID) { entry.valid = false; }
+	}
+}
+
+void MemoryManager::TLB::flush() {
+	for (auto& entry : entries) { entry.valid = false; }
+	flushes++;
+}
+
+//------------- Plik wymiany na dysku  --------------
+bool MemoryManager::SwapFile::open(const string& path, size_t slots) {
+#ifdef _WIN32
+	file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) { file = nullptr; return false; }
+#else
+	descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (descriptor == -1) { return false; }
+#endif
+	this->path = path;
+
+	//Plik od razu dostaje trochę zapasu, żeby nie mapować go ponownie przy każdym nowym slocie
+	if (!map(max<size_t>(slots, 64))) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool MemoryManager::SwapFile::reserve(size_t slots) {
+	if (slots <= capacity) { return true; }
+
+	//Zawartość jest już w pliku, więc wystarczy zmapować go ponownie w większym rozmiarze
+	//Stare odwzorowanie jest zwalniane dopiero po utworzeniu nowego - przy błędzie sloty pozostają dostępne
+	char* const previousView = view;
+	const size_t previous = capacity;
+#ifdef _WIN32
+	void* const previousMapping = mapping;
+#endif
+	if (!map(max(slots, previous * 2))) {
+		view = previousView;
+		capacity = previous;
+#ifdef _WIN32
+		mapping = previousMapping;
+#endif
+		return false;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(previousView);
+	CloseHandle(previousMapping);
+#else
+	munmap(previousView, previous * 16);
+#endif
+	return true;
+}
+
+bool MemoryManager::SwapFile::map(size_t slots) {
+	const size_t bytes = slots * 16;
+#ifdef _WIN32
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<unsigned long long>(bytes) >> 32), static_cast<DWORD>(bytes & 0xFFFFFFFF), nullptr);
+	if (mapping == nullptr) { return false; }
+	view = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes));
+	if (view == nullptr) {
+		CloseHandle(mapping);
+		mapping = nullptr;
+		return false;
+	}
+#else
+	if (ftruncate(descriptor, bytes) != 0) { return false; }
+	void* address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	if (address == MAP_FAILED) { return false; }
+	view = static_cast<char*>(address);
+#endif
+	capacity = slots;
+	return true;
+}
+
+void MemoryManager::SwapFile::unmap() {
+#ifdef _WIN32
+	if (view != nullptr) { UnmapViewOfFile(view); }
+	if (mapping != nullptr) { CloseHandle(mapping); }
+	mapping = nullptr;
+#else
+	if (view != nullptr) { munmap(view, capacity * 16); }
+#endif
+	view = nullptr;
+	capacity = 0;
+}
+
+void MemoryManager::SwapFile::close() {
+	unmap();
+#ifdef _WIN32
+	if (file != nullptr) { CloseHandle(file); }
+	file = nullptr;
+#else
+	if (descriptor != -1) { ::close(descriptor); }
+	descriptor = -1;
+#endif
+	path.clear();
+}
+
+bool MemoryManager::SwapFile::is_open() const { return view != nullptr; }
+
+const string& MemoryManager::SwapFile::name() const { return path; }
+
+size_t MemoryManager::SwapFile::size() const { return capacity; }
+
+char* MemoryManager::SwapFile::slot(int slot) const { return view + static_cast<size_t>(slot) * 16; }
+
+MemoryManager::SwapFile::~SwapFile() { close(); }
+
+bool MemoryManager::ProgramFile::open(const string& path) {
+#ifdef _WIN32
+	file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) { file = nullptr; return false; }
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize)) { close(); return false; }
+	length = static_cast<size_t>(fileSize.QuadPart);
+
+	if (length >= MAP_THRESHOLD) {
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping != nullptr) { view = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)); }
+		if (view != nullptr) { mapped = true; return true; }
+	}
+	//Mały plik (albo nieudane mapowanie) - cała zawartość wczytana jednym odczytem
+	buffer.resize(length);
+	DWORD done = 0;
+	for (size_t total = 0; total < length; total += done) {
+		const DWORD chunk = static_cast<DWORD>(min<size_t>(length - total, 1 << 30));
+		if (!ReadFile(file, buffer.data() + total, chunk, &done, nullptr) || done == 0) { close(); return false; }
+	}
+#else
+	const int descriptor = ::open(path.c_str(), O_RDONLY);
+	if (descriptor == -1) { return false; }
+	const off_t fileSize = lseek(descriptor, 0, SEEK_END);
+	if (fileSize < 0) { ::close(descriptor); return false; }
+	length = static_cast<size_t>(fileSize);
+
+	if (length >= MAP_THRESHOLD) {
+		void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if (address != MAP_FAILED) {
+			//Odwzorowanie pozostaje ważne po zamknięciu deskryptora
+			::close(descriptor);
+			view = static_cast<const char*>(address);
+			mapped = true;
+			return true;
+		}
+	}
+	//Mały plik (albo nieudane mapowanie) - cała zawartość wczytana jednym odczytem
+	buffer.resize(length);
+	for (size_t total = 0; total < length;) {
+		const ssize_t done = pread(descriptor, buffer.data() + total, length - total, static_cast<off_t>(total));
+		if (done <= 0) { ::close(descriptor); buffer.clear(); length = 0; return false; }
+		total += static_cast<size_t>(done);
+	}
+	::close(descriptor);
+#endif
+	view = buffer.data();
+	return true;
+}
+
+void MemoryManager::ProgramFile::close() {
+#ifdef _WIN32
+	if (mapped) { UnmapViewOfFile(view); }
+	if (mapping != nullptr) { CloseHandle(mapping); }
+	if (file != nullptr) { CloseHandle(file); }
+	mapping = nullptr;
+	file = nullptr;
+#else
+	if (mapped) { munmap(const_cast<char*>(view), length); }
+#endif
+	buffer.clear();
+	view = nullptr;
+	length = 0;
+	mapped = false;
+}
 
-	//Panie Kasperczak, zapomniał Pan, że w mapie trzeba najpierw stworzyć pozycję
-	//PageFile[PID] gdy nie ma pozycji to ją tworzy
+const char* MemoryManager::ProgramFile::data() const { return view; }
+
+size_t MemoryManager::ProgramFile::size() const { return length; }
+
+bool MemoryManager::ProgramFile::is_mapped() const { return mapped; }
+
+MemoryManager::ProgramFile::~ProgramFile() { close(); }
+
+//------------- Funkcje użytkowe MemoryManagera  --------------
+void MemoryManager::memory_init() {
+	fill(RAM.begin(), RAM.end(), ' ');
+	for (size_t i = 0; i < Frames.size(); i++) { mark_changed(static_cast<int>(i)); }
+	ProgramSlots.emplace(pair(1, vector<int>{ alloc_slot(Page("JMP [0];")) }));
+}
+
+void MemoryManager::stack_update(int frameID) {
+	if (frameID < 0 || frameID >= static_cast<int>(Frames.size())) return;
+
+	//Przeniesienie węzła listy na koniec - bez alokacji, pozycja ramki pozostaje ważna
+	Stack.splice(Stack.end(), Stack, Frames[frameID].stackPosition);
+}
+
+void MemoryManager::mark_changed(int frame) { Frames[frame].generation = memoryGeneration; }
+
+int MemoryManager::create_page_list(int mem, int PID) {
+	const double pages = ceil(static_cast<double>(mem) / 16);
+	//Proces większy niż przestrzeń adresowa tablicy - sloty programu zwalnia kill
+	if (mem < 0 || static_cast<unsigned int>(mem) > PageTable::address_limit(PageTable::defaultLevels)) {
+		cout << "Error: Proces nie miesci sie w przestrzeni adresowej tablicy stronic (max " << PageTable::address_limit(PageTable::defaultLevels) << " B)!\n";
+		return -1;
+	}
+	const int table = alloc_page_table(PageTable::defaultLevels, PID);
+	PageTable& pageList = PageTableArena[table];
+
+	//Stronice poza programem istnieją tylko jako flaga - slot dostaną przy pierwszym dostępie
+	pageList.resize(static_cast<size_t>(pages));
+
+	//Sloty programu wczytanego przez load_program trafiają do tablicy stronic
+	const auto program = ProgramSlots.find(PID);
+	if (program != ProgramSlots.end()) {
+		for (size_t i = 0; i < program->second.size(); i++) {
+			PageTableData& entry = pageList.at(i);
+			entry.slot = program->second[i];
+			entry.zero = false;
+			//Stronice współdzielone z innymi procesami (np. kod programu) są tylko do odczytu aż do pierwszego zapisu
+			if (PageSlots[entry.slot].references > 1) { entry.cow = true; }
+		}
+		ProgramSlots.erase(program);
+	}
 
 	//Załadowanie pierszej stronicy naszego programu do Pamięci RAM
-	load_to_memory(PageFile[PID].at(0), 0, PID, pageList);
+	const PageTableData* first = pageList.find(0);
+	if (first != nullptr && first->slot != -1) { load_to_memory(first->slot, 0, PID, table); }
 
-	return pageList;
+	return table;
+}
+
+int MemoryManager::alloc_page_table(int levels, int PID) {
+	int table;
+	if (!FreePageTables.empty()) {
+		table = FreePageTables.back();
+		FreePageTables.pop_back();
+		PageTableArena[table].reset(levels);
+	}
+	else {
+		table = static_cast<int>(PageTableArena.size());
+		PageTableArena.emplace_back(levels);
+	}
+	PageTables[PID] = table;
+	return table;
 }
 
-void MemoryManager::resize_page_list(int size, PCB* proc) {
-	for (int i = int(ceil(proc->size / 16.0)); i < int(ceil((size / 16.0))); i++) {
-		proc->pageList->push_back(PageTableData(false, 0));
-		PageFile[proc->PID].emplace_back(Page());
+PageTable& MemoryManager::page_table(int table) { return PageTableArena[table]; }
+
+const PageTable& MemoryManager::page_table(int table) const { return PageTableArena[table]; }
+
+int MemoryManager::resize_page_list(int size, PCB* proc) {
+	//Stronica na żądanie - slot powstanie przy pierwszym dostępie
+	if (!PageTableArena[proc->pageTable].resize(static_cast<size_t>(ceil(size / 16.0)))) {
+		cout << "Error: Rozmiar " << size << " B przekracza przestrzen adresowa procesu!\n";
+		return -1;
 	}
 	proc->size = static_cast<unsigned int>(ceil(size / 16.0)) * 16;
+	return 1;
 }
 
 int MemoryManager::seek_free_frame() {
-	int seekedFrame = -1;
+	if (FreeFrames.empty()) { return -1; }
+	return *FreeFrames.begin();
+}
 
+void MemoryManager::kill(int PID) {
+	tlb.invalidate_process(PID);
+
+	//Najpierw oddawane są sloty pliku stronicowania - stronice nieużywane przez inne procesy nie są już zapisywane
+	const auto table = PageTables.find(PID);
+	if (table != PageTables.end()) {
+		PageTableArena[table->second].for_each([&](int, const PageTableData& entry) { release_slot(entry.slot); });
+		FreePageTables.push_back(table->second);
+		PageTables.erase(table);
+	}
+	const auto program = ProgramSlots.find(PID);
+	if (program != ProgramSlots.end()) {
+		for (const int slot : program->second) { release_slot(slot); }
+		ProgramSlots.erase(program);
+	}
 
-	for (size_t i = 0; i < Frames.size(); i++) {
-		if (Frames[i].isFree) {
-			seekedFrame = i;
-			break;
+	//Ostatni proces uruchomiony z programu zwalnia referencje obrazu do stronic kodu
+	const auto used = ProcessImages.find(PID);
+	if (used != ProcessImages.end()) {
+		const auto image = ProgramImages.find(used->second);
+		if (image != ProgramImages.end() && --image->second.users == 0) {
+			for (const int slot : image->second.slots) { release_slot(slot); }
+			ProgramImages.erase(image);
+		}
+		ProcessImages.erase(used);
+	}
+
+	//Zwalnianie tylko tych ramek, które zajmuje proces (ramki współdzielone zostają u pozostałych właścicieli)
+	const auto resident = ResidentFrames.find(PID);
+	if (resident != ResidentFrames.end()) {
+		while (resident->second.first != -1) {
+			const int owner = resident->second.first;
+			const int frame = Owners[owner].frame;
+			if (PageTableArena[Owners[owner].table].at(Owners[owner].pageID).prefetched) { GlobalStats.prefetchMisses++; }
+			release_owner(owner);
+			if (Frames[frame].owners == -1) { release_frame(frame); }
 		}
+		ResidentFrames.erase(resident);
 	}
-	return seekedFrame;
+
+	ProcessStats.erase(PID);
+	Prefetch.erase(PID);
+	Quotas.erase(PID);
 }
 
-void MemoryManager::kill(int PID) {
-	for (size_t i = 0; i < Frames.size(); i++) {
-		if (Frames[i].PID == PID) {
-			for (size_t j = i * 16; j < i * 16 + 16; j++)
-				RAM[j] = ' ';
-			stack_update(i);
-			Frames[i].isFree = true;
-			Frames[i].pageID = -1;
-			Frames[i].PID = -1;
-			PageFile.erase(PID);
+int MemoryManager::swap_out(int PID) {
+	const auto resident = ResidentFrames.find(PID);
+	if (resident == ResidentFrames.end()) { return 0; }
+
+	int frames = 0;
+	while (resident->second.first != -1) {
+		const int frame = Owners[resident->second.first].frame;
+		unmap_frame(resident->second.first);
+		//Ramka współdzielona zostaje w pamięci u pozostałych właścicieli
+		if (Frames[frame].owners == -1) { release_frame(frame); }
+		frames++;
+	}
+
+	//Po wznowieniu ciąg sekwencyjnych błędów stronicy zaczyna się od nowa
+	Prefetch.erase(PID);
+	return frames;
+}
+
+void MemoryManager::map_frame(int frame, int pageID, int PID, int table) {
+	PageTableData& entry = PageTableArena[table].at(pageID);
+	entry.bit = true;
+	entry.frame = frame;
+
+	//Wpis właściciela z puli (zwolniony wcześniej albo nowy)
+	int owner;
+	if (!FreeOwners.empty()) {
+		owner = FreeOwners.back();
+		FreeOwners.pop_back();
+	}
+	else {
+		owner = static_cast<int>(Owners.size());
+		Owners.emplace_back();
+	}
+	Owners[owner] = FrameOwner{ PID, pageID, table, frame };
+
+	//Dopisanie na koniec listy właścicieli ramki (pierwszy właściciel pozostaje na początku)
+	if (Frames[frame].owners == -1) { Frames[frame].owners = owner; }
+	else {
+		int last = Frames[frame].owners;
+		while (Owners[last].nextOwner != -1) { last = Owners[last].nextOwner; }
+		Owners[last].nextOwner = owner;
+	}
+	Frames[frame].ownerCount++;
+
+	//Dopisanie na koniec listy ramek procesu
+	ResidentList& processFrames = ResidentFrames[PID];
+	Owners[owner].prevResident = processFrames.last;
+	if (processFrames.last == -1) { processFrames.first = owner; }
+	else { Owners[processFrames.last].nextResident = owner; }
+	processFrames.last = owner;
+
+	ProcessStats[PID].resident++;
+}
+
+void MemoryManager::unmap_frame(int owner) {
+	const FrameOwner& data = Owners[owner];
+	PageTableData& entry = PageTableArena[data.table].at(data.pageID);
+	entry.bit = false;
+	entry.frame = -1;
+
+	//Stronica sprowadzona z wyprzedzeniem opuszcza pamięć, zanim proces z niej skorzystał
+	if (entry.prefetched) {
+		entry.prefetched = false;
+		ProcessStats[data.PID].prefetchMisses++;
+		GlobalStats.prefetchMisses++;
+	}
+
+	ProcessStats[data.PID].resident--;
+	tlb.invalidate_page(data.PID, data.pageID);
+	release_owner(owner);
+}
+
+void MemoryManager::release_owner(int owner) {
+	FrameOwner& data = Owners[owner];
+
+	//Usunięcie z listy właścicieli ramki
+	FrameData& frame = Frames[data.frame];
+	if (frame.owners == owner) { frame.owners = data.nextOwner; }
+	else {
+		int previous = frame.owners;
+		while (Owners[previous].nextOwner != owner) { previous = Owners[previous].nextOwner; }
+		Owners[previous].nextOwner = data.nextOwner;
+	}
+	frame.ownerCount--;
+
+	//Usunięcie z listy ramek procesu
+	ResidentList& processFrames = ResidentFrames[data.PID];
+	if (data.prevResident == -1) { processFrames.first = data.nextResident; }
+	else { Owners[data.prevResident].nextResident = data.nextResident; }
+	if (data.nextResident == -1) { processFrames.last = data.prevResident; }
+	else { Owners[data.nextResident].prevResident = data.prevResident; }
+
+	FreeOwners.push_back(owner);
+}
+
+void MemoryManager::release_frame(int frame) {
+	PageSlot& page = PageSlots[Frames[frame].slot];
+
+	//Zawartość zmodyfikowanej ramki wraca do slotu, jeśli ktoś jeszcze z niego korzysta
+	if (Frames[frame].dirty && page.references > 0) {
+		page_out(Frames[frame].slot, &RAM[frame * 16]);
+		GlobalStats.writeBacks++;
+	}
+	page.frame = -1;
+
+	memset(&RAM[frame * 16], ' ', 16);
+	mark_changed(frame);
+	stack_update(frame);
+	Frames[frame].isFree = true;
+	Frames[frame].slot = -1;
+	Frames[frame].dirty = false;
+	FreeFrames.insert(frame);
+	GlobalStats.resident--;
+	tlb.invalidate_frame(frame);
+}
+
+int MemoryManager::alloc_slot(const Page& page) {
+	int slot;
+	if (!FreeSlots.empty()) {
+		slot = FreeSlots.back();
+		FreeSlots.pop_back();
+	}
+	else {
+		slot = static_cast<int>(PageSlots.size());
+		//Nieudane powiększenie zostawia stare odwzorowanie - sloty są przepisywane do pamięci, a plik zamykany
+		if (swapFile.is_open() && !swapFile.reserve(slot + 1)) {
+			cout << "Error: Cannot grow swap file, page file moved back to memory!\n";
+			set_swap_file("");
 		}
+		PageSlots.emplace_back();
+		if (!swapFile.is_open() && !compressedSwap) { SlotMemory.resize(PageSlots.size() * 16); }
 	}
+	store_slot(slot, page.data);
+	PageSlots[slot].references = 1;
+	PageSlots[slot].frame = -1;
+	return slot;
 }
 
-int MemoryManager::load_program(const string& path, int PID) {
-	fstream file(path);			//Plik na dysku
-	string scrap;				//Zmienna pomocnicza
-	string program;				//Program w jednej linii
-	vector<Page> pageVector;	//Wektor stronic do dodania
+char* MemoryManager::slot_data(int slot) {
+	return swapFile.is_open() ? swapFile.slot(slot) : &SlotMemory[slot * 16];
+}
 
-	if (!file.is_open()) {
-		cout << "Error: Nie mozna otworzyc pliku! \n";
-		return -1;
+const char* MemoryManager::slot_data(int slot) const {
+	return swapFile.is_open() ? swapFile.slot(slot) : &SlotMemory[slot * 16];
+}
+
+void MemoryManager::release_slot(int slot) {
+	if (slot == -1) { return; }
+	if (--PageSlots[slot].references == 0) {
+		FreeSlots.push_back(slot);
+
+		//Miejsce w obszarze wymiany na dysku wraca do puli
+		if (PageSlots[slot].disk != -1) {
+			FreeDiskSlots.push_back(PageSlots[slot].disk);
+			PageSlots[slot].disk = -1;
+		}
+
+		//Skompresowana zawartość zwolnionego slotu staje się nieaktualna
+		if (compressedSwap) {
+			poolGarbage += PageSlots[slot].length;
+			PageSlots[slot].length = 0;
+			PageSlots[slot].fill = ' ';
+		}
+	}
+}
+
+void MemoryManager::page_out(int slot, const char* data) {
+	PageSlot& page = PageSlots[slot];
+	if (diskSwap && page.disk == -1) {
+		page.disk = alloc_disk_slot();
+		if (page.disk == -1) { DiskSwap.overflows++; }
+	}
+	if (page.disk != -1) { DiskSwap.pageOuts++; }
+	store_slot(slot, data);
+}
+
+int MemoryManager::alloc_disk_slot() {
+	if (FreeDiskSlots.empty()) {
+		if (static_cast<int>(SwapBlocks.size()) >= diskSwapLimit) { return -1; }
+		const int block = fm.swap_reserve_block();
+		if (block == -1) { return -1; }
+		SwapBlocks.push_back(block);
+
+		const int pagesPerBlock = static_cast<int>(FileManager::get_block_size()) / 16;
+		for (int i = pagesPerBlock - 1; i >= 0; i--) { FreeDiskSlots.push_back(block * pagesPerBlock + i); }
+	}
+	const int position = FreeDiskSlots.back();
+	FreeDiskSlots.pop_back();
+	return position;
+}
+
+void MemoryManager::store_slot(int slot, const char* data) {
+	//Stronica w obszarze wymiany - zapis bloku dysku
+	if (PageSlots[slot].disk != -1) {
+		const int pagesPerBlock = static_cast<int>(FileManager::get_block_size()) / 16;
+		fm.swap_write(PageSlots[slot].disk / pagesPerBlock, PageSlots[slot].disk % pagesPerBlock * 16, string(data, 16));
+		return;
+	}
+	if (!compressedSwap) {
+		memcpy(slot_data(slot), data, 16);
+		return;
+	}
+
+	const auto begin = chrono::steady_clock::now();
+	PageSlot& page = PageSlots[slot];
+	poolGarbage += page.length;
+
+	char packed[16];
+	page.length = static_cast<unsigned char>(compress_page(data, packed));
+	if (page.length == 0) {
+		page.fill = data[0];
+		page.offset = -1;
+	}
+	else {
+		page.offset = static_cast<int>(CompressedPool.size());
+		CompressedPool.insert(CompressedPool.end(), packed, packed + page.length);
+	}
+
+	Compression.compressions++;
+	Compression.compressNs += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - begin).count();
+
+	if (poolGarbage > 4096 && poolGarbage * 2 > CompressedPool.size()) { compact_pool(); }
+}
+
+void MemoryManager::load_slot(int slot, char* out) {
+	//Stronica w obszarze wymiany - odczyt bloku dysku
+	if (PageSlots[slot].disk != -1) {
+		const int pagesPerBlock = static_cast<int>(FileManager::get_block_size()) / 16;
+		const string data = fm.swap_read(PageSlots[slot].disk / pagesPerBlock, PageSlots[slot].disk % pagesPerBlock * 16, 16);
+		memcpy(out, data.data(), 16);
+		DiskSwap.pageIns++;
+		return;
+	}
+	if (!compressedSwap) {
+		memcpy(out, slot_data(slot), 16);
+		return;
+	}
+
+	const auto begin = chrono::steady_clock::now();
+	peek_slot(slot, out);
+	Compression.decompressions++;
+	Compression.decompressNs += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - begin).count();
+}
+
+void MemoryManager::peek_slot(int slot, char* out) const {
+	if (PageSlots[slot].disk != -1) {
+		const int pagesPerBlock = static_cast<int>(FileManager::get_block_size()) / 16;
+		const string data = fm.swap_read(PageSlots[slot].disk / pagesPerBlock, PageSlots[slot].disk % pagesPerBlock * 16, 16, false);
+		memcpy(out, data.data(), 16);
+		return;
+	}
+	if (!compressedSwap) {
+		memcpy(out, slot_data(slot), 16);
+		return;
+	}
+
+	const PageSlot& page = PageSlots[slot];
+	decompress_page(page.length == 0 ? nullptr : &CompressedPool[page.offset], page.length, page.fill, out);
+}
+
+void MemoryManager::compact_pool() {
+	vector<char> pool;
+	pool.reserve(CompressedPool.size() - poolGarbage);
+	for (auto& page : PageSlots) {
+		if (page.length == 0) continue;
+		const int offset = static_cast<int>(pool.size());
+		pool.insert(pool.end(), CompressedPool.begin() + page.offset, CompressedPool.begin() + page.offset + page.length);
+		page.offset = offset;
+	}
+	CompressedPool.swap(pool);
+	poolGarbage = 0;
+}
+
+int MemoryManager::compress_page(const char* page, char* out) {
+	//Stronica wypełniona jednym znakiem
+	if (all_of(page, page + 16, [page](char c) { return c == page[0]; })) { return 0; }
+
+	//Token < 0x80: (token + 1) literałów, token >= 0x80: powtórzenie (token & 0x7F) + 3 bajtów sprzed offset bajtów
+	int length = 0;
+	int literal = -1; //Pozycja tokenu bieżącego ciągu literałów
+	for (int i = 0; i < 16;) {
+		int bestLength = 0;
+		int bestOffset = 0;
+		for (int offset = 1; offset <= i; offset++) {
+			int match = 0;
+			while (i + match < 16 && page[i + match] == page[i + match - offset]) { match++; }
+			if (match > bestLength) { bestLength = match; bestOffset = offset; }
+		}
+
+		//Kompresja się nie opłaca - stronica zapisana bez zmian
+		const int needed = (bestLength >= 3 || literal == -1) ? 2 : 1;
+		if (length + needed >= 16) {
+			memcpy(out, page, 16);
+			return 16;
+		}
+
+		if (bestLength >= 3) {
+			out[length++] = static_cast<char>(0x80 | (bestLength - 3));
+			out[length++] = static_cast<char>(bestOffset);
+			i += bestLength;
+			literal = -1;
+		}
+		else {
+			if (literal == -1) {
+				literal = length;
+				out[length++] = static_cast<char>(-1);
+			}
+			out[literal]++;
+			out[length++] = page[i++];
+		}
+	}
+
+	return length;
+}
+
+void MemoryManager::decompress_page(const char* in, int length, char fill, char* page) {
+	if (length == 0) {
+		memset(page, fill, 16);
+		return;
 	}
+	if (length == 16) {
+		memcpy(page, in, 16);
+		return;
+	}
+
+	int i = 0;
+	for (int n = 0; n < length && i < 16;) {
+		const unsigned char token = static_cast<unsigned char>(in[n++]);
+		if (token & 0x80) {
+			const int offset = static_cast<unsigned char>(in[n++]);
+			for (int k = 0; k < (token & 0x7F) + 3 && i < 16; k++, i++) { page[i] = page[i - offset]; }
+		}
+		else {
+			for (int k = 0; k <= token && i < 16; k++) { page[i++] = in[n++]; }
+		}
+	}
+}
 
-	while (getline(file, scrap)) {
-		//Dodanie spacji zamiast końca linii
-		if (!scrap.empty()) {
-			scrap += ";";
-			program += scrap;
+int MemoryManager::fork_page_list(const shared_ptr<PCB>& parent, int PID) {
+	//Tablica dziecka powstaje przed pobraniem referencji - dodanie tablicy do puli może ją przenieść
+	const int table = alloc_page_table(PageTableArena[parent->pageTable].levels(), PID);
+	PageTable& parentList = PageTableArena[parent->pageTable];
+	PageTable& pageList = PageTableArena[table];
+	pageList.resize(parentList.size());
+	vector<int> resident; //Stronice, które przy pełnej kopii trzeba sprowadzić do pamięci dziecka
+
+	//Nieutworzone węzły tablicy rodzica zawierają tylko stronice na żądanie - dziecko też dostanie je przy pierwszym dostępie
+	parentList.for_each([&](int i, PageTableData& parentEntry) {
+		//Nieużywana jeszcze stronica - dziecko też dostanie ją dopiero przy pierwszym dostępie
+		if (parentEntry.slot == -1) return;
+
+		PageTableData& entry = pageList.at(i);
+		entry.zero = parentEntry.zero;
+		if (parentEntry.shared) {
+			//Segment pamięci współdzielonej zostaje współdzielony również z dzieckiem (w obu trybach)
+			PageSlots[parentEntry.slot].references++;
+			entry.slot = parentEntry.slot;
+			entry.shared = true;
+			if (parentEntry.bit) { map_frame(parentEntry.frame, i, PID, table); }
 		}
+		else if (copyOnWriteFork) {
+			//Dziecko dostaje ten sam slot i tę samą ramkę, obie strony mogą tylko czytać
+			PageSlots[parentEntry.slot].references++;
+			entry.slot = parentEntry.slot;
+			parentEntry.cow = true;
+			entry.cow = true;
+			if (parentEntry.bit) { map_frame(parentEntry.frame, i, PID, table); }
+		}
+		else {
+			//Pełna kopia - aktualna zawartość stronicy jest w ramce, jeśli stronica jest w pamięci RAM
+			Page copy;
+			load_slot(parentEntry.slot, copy.data);
+			if (parentEntry.bit) {
+				memcpy(copy.data, &RAM[parentEntry.frame * 16], 16);
+				resident.push_back(i);
+			}
+			entry.slot = alloc_slot(copy);
+		}
+	});
+
+	//Przy pełnej kopii dziecko dostaje własne ramki dla stronic, które rodzic ma w pamięci
+	for (const int i : resident) {
+		if (parentList.at(i).bit && !pageList.at(i).bit) { load_to_memory(pageList.at(i).slot, i, PID, table); }
+	}
+
+	//Dziecko jest dołączone do tych samych segmentów co rodzic
+	for (auto& segment : Segments) {
+		if (segment.second.attached.count(parent->PID) != 0) { segment.second.attached.insert(PID); }
+	}
+
+	return table;
+}
+
+int MemoryManager::shm_get(const string& name, int size) {
+	if (size <= 0) {
+		cout << "Error: Invalid shared memory segment size!\n";
+		return -1;
+	}
+	if (Segments.find(name) != Segments.end()) { return 0; }
+
+	SharedSegment& segment = Segments[name];
+	for (int i = 0; i < ceil(size / 16.0); i++) {
+		segment.slots.push_back(alloc_slot(Page()));
+	}
+	return 1;
+}
+
+int MemoryManager::shm_attach(const shared_ptr<PCB>& process, const string& name) {
+	const auto segment = Segments.find(name);
+	if (segment == Segments.end()) {
+		cout << "Error: Shared memory segment \"" << name << "\" does not exist!\n";
+		return -1;
+	}
+	if (segment->second.attached.count(process->PID) != 0) {
+		cout << "Error: Shared memory segment \"" << name << "\" is already attached!\n";
+		return -1;
+	}
+
+	//Stronice segmentu trafiają na koniec tablicy stronic procesu - segment musi zmieścić się w przestrzeni adresowej
+	PageTable& pageList = PageTableArena[process->pageTable];
+	const int base = static_cast<int>(pageList.size()) * 16;
+	int pageID = static_cast<int>(pageList.size());
+	if (!pageList.resize(pageList.size() + segment->second.slots.size())) {
+		cout << "Error: Shared memory segment \"" << name << "\" does not fit in the address space (max " << pageList.max_address() << " B)!\n";
+		return -1;
+	}
+	segment->second.attached.insert(process->PID);
+	for (const int slot : segment->second.slots) {
+		PageSlots[slot].references++;
+		PageTableData& entry = pageList.at(pageID++);
+		entry.slot = slot;
+		entry.zero = false;
+		entry.shared = true;
 	}
-	const double pagesAmount = ceil(program.length() / 16.0);
-	scrap.clear();
+	process->size = static_cast<unsigned int>(pageList.size()) * 16;
+
+	return base;
+}
 
-	//Dzielenie programu na stronice
-	for (char i : program) {
-		scrap += i;
-		//Tworzenie Stronicy
-		if (scrap.size() == 16) {
-			pageVector.emplace_back(Page(scrap));
-			scrap.clear();
+void MemoryManager::shm_detach_all(int PID) {
+	for (auto segment = Segments.begin(); segment != Segments.end();) {
+		if (segment->second.attached.erase(PID) != 0 && segment->second.attached.empty()) {
+			for (const int slot : segment->second.slots) { release_slot(slot); }
+			segment = Segments.erase(segment);
 		}
+		else { ++segment; }
 	}
+}
+
+void MemoryManager::set_fork_mode(bool copyOnWrite) { copyOnWriteFork = copyOnWrite; }
+
+bool MemoryManager::get_fork_mode() const { return copyOnWriteFork; }
 
-	if (!scrap.empty()) { pageVector.emplace_back(Page(scrap)); }
-	scrap.clear();
+int MemoryManager::load_program(const string& path, int PID, string& program) {
+	ProgramFile file;			//Zawartość pliku na dysku
+	vector<int> pageVector;		//Wektor slotów ze stronicami do dodania
 
-	if (pagesAmount * 16 < 16 * pageVector.size()) {
-		cout << "Error: proces nie ma przypisane wystarczajaco duzo pamieci!\n";
+	if (!file.open(path)) {
+		cout << "Error: Nie mozna otworzyc pliku! \n";
 		return -1;
 	}
 
+	//Jedno przejście po zawartości - puste linie są pomijane, a koniec każdej linii zastępuje ';'
+	program.clear();
+	program.reserve(file.size() + 1);
+	const char* const begin = file.data();
+	const char* const end = begin + file.size();
+	for (const char* line = begin; line < end;) {
+		const char* lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+		if (lineEnd == nullptr) { lineEnd = end; }
+		const char* textEnd = lineEnd;
+		if (textEnd > line && *(textEnd - 1) == '\r') { textEnd--; }
+		if (textEnd > line) {
+			program.append(line, textEnd);
+			program += ';';
+		}
+		line = lineEnd + 1;
+	}
+	file.close();
 
-	//Sprawdzanie, czy program nie potrzebuje wiecej stronic w pamięci
-	for (int i = pageVector.size(); i < pagesAmount; i++)
-		pageVector.emplace_back(scrap);
+	//Program większy niż przestrzeń adresowa procesu nie trafia do pliku wymiany
+	if (program.length() > PageTable::address_limit(PageTable::defaultLevels)) {
+		cout << "Error: Program nie miesci sie w przestrzeni adresowej procesu (max " << PageTable::address_limit(PageTable::defaultLevels) << " B)!\n";
+		return -1;
+	}
 
-	//Dodanie stronic do pliku wymiany
-	PageFile.insert(make_pair(PID, pageVector));
+	//Program był już załadowany - proces korzysta z tych samych stronic kodu
+	const ImageKey key(path, hash<string>()(program));
+	ProcessImages[PID] = key;
+	const auto image = ProgramImages.find(key);
+	if (image != ProgramImages.end()) {
+		for (const int slot : image->second.slots) { PageSlots[slot].references++; }
+		ProgramSlots[PID] = image->second.slots;
+		image->second.users++;
+		return program.length();
+	}
+
+	//Dzielenie programu na stronice - każda stronica powstaje od razu z 16-bajtowego fragmentu
+	pageVector.reserve((program.length() + 15) / 16);
+	for (size_t offset = 0; offset < program.length(); offset += 16) {
+		pageVector.push_back(alloc_slot(Page(program.data() + offset, min<size_t>(16, program.length() - offset))));
+	}
+
+	//Dodanie stronic do pliku wymiany i zapamiętanie obrazu programu dla kolejnych procesów
+	ProgramSlots[PID] = pageVector;
+	for (const int slot : pageVector) { PageSlots[slot].references++; }
+	ProgramImage& loaded = ProgramImages[key];
+	loaded.slots = move(pageVector);
+	loaded.users = 1;
 
 	return program.length();
 }
 
-int MemoryManager::load_to_memory(Page page, int pageID, int PID, const shared_ptr<vector<PageTableData>>& pageList) {
-	int frame = seek_free_frame();
+int MemoryManager::load_to_memory(int slot, int pageID, int PID, int table) {
+	//Stronica jest już w pamięci RAM (współdzielona z innym procesem) - wystarczy wpis w tablicy stronic
+	if (PageSlots[slot].frame != -1) {
+		map_frame(PageSlots[slot].frame, pageID, PID, table);
+		return PageSlots[slot].frame;
+	}
+
+	//Proces, który osiągnął limit ramek, wymienia własne stronice nawet, gdy są wolne ramki
+	int frame = at_frame_limit(PID) ? -1 : seek_free_frame();
 
 	if (frame == -1) { frame = insert_page(pageID, PID); }
 
 	//Przepisywanie stronicy do pamięci RAM
-	int it = 0;
-	const int end = frame * 16 + 16;
-	for (int i = frame * 16; i < end; i++)
-		RAM[i] = page.data[it++];
-
-	//Zmienianie bit'u w indeksie wymiany stronic
-	pageList->at(pageID).bit = true;
-	pageList->at(pageID).frame = frame;
+	load_slot(slot, &RAM[frame * 16]);
+	PageSlots[slot].frame = frame;
+	mark_changed(frame);
+
+	//Statystyki - stronica nieużywana wcześniej zostaje wypełniona pustymi danymi
+	PagingStats& stats = ProcessStats[PID];
+	PageTableData& entry = PageTableArena[table].at(pageID);
+	if (entry.zero) {
+		entry.zero = false;
+		stats.zeroFills++;
+		GlobalStats.zeroFills++;
+	}
+	GlobalStats.resident++;
 
 	//Aktualizacja stosu używalności
 	stack_update(frame);
 
 	//Aktualizacja informacji o ramce
+	FreeFrames.erase(frame);
 	Frames[frame].isFree = false;
-	Frames[frame].pageID = pageID;
-	Frames[frame].PID = PID;
-	Frames[frame].pageList = pageList;
+	Frames[frame].slot = slot;
+	Frames[frame].dirty = false;
+
+	//Zmienianie bit'u w indeksie wymiany stronic
+	map_frame(frame, pageID, PID, table);
 
 	return frame;
 }
 
-string MemoryManager::get_byte(const shared_ptr<PCB>& process, int address) {
-	string response;
-	unsigned int PageID = address / 16;
+int MemoryManager::get_frame(const shared_ptr<PCB>& process, int pageID, bool write, bool fetch) {
+	PageTableData& entry = PageTableArena[process->pageTable].at(pageID);
+	trace_access(process->PID, pageID, write);
 
-	//przekroczenie zakres dla tego procesu
-	if (process->pageList->size() <= PageID) {
-		cout << "Error: Exceeded memory range!";
-		return "ERROR";
-	}
+	//Pierwszy zapis do stronicy współdzielonej - proces dostaje własną kopię
+	if (write && entry.cow) { copy_on_write(process, pageID); }
 
-	PageID = address / 16; //Numer stronicy w pamięci
+	//Szybka ścieżka - tłumaczenie znajduje się w buforze TLB
+	tlb.switch_to(process->PID);
+	const int cached = tlb.lookup(process->PID, pageID);
+	if (cached != -1) { return cached; }
 
 	//Sprawdza, czy stronica znajduje się w pamięci operacyjnej
-	if (!process->pageList->at(PageID).bit)
-		load_to_memory(PageFile[process->PID][PageID], PageID, process->PID, process->pageList);
+	if (!entry.bit) {
+		PagingStats& stats = ProcessStats[process->PID];
+		stats.faults++; stats.pendingFaults++;
+		GlobalStats.faults++; GlobalStats.pendingFaults++;
+		//Pierwszy dostęp do stronicy na żądanie - dopiero teraz powstaje dla niej slot
+		if (entry.slot == -1) { entry.slot = alloc_slot(Page()); }
+		load_to_memory(entry.slot, pageID, process->PID, process->pageTable);
+
+		if (fetch) { read_ahead(process, pageID); }
+	}
+	//Pierwsze użycie stronicy sprowadzonej z wyprzedzeniem
+	else if (entry.prefetched) {
+		entry.prefetched = false;
+		ProcessStats[process->PID].prefetchHits++;
+		GlobalStats.prefetchHits++;
+	}
 
-	if (process->pageList->at(PageID).bit) {
-		const int Frame = process->pageList->at(PageID).frame;//Bieżąco używana ramka
+	//stack_update(entry.frame);//Ramka została użyta, więc trzeba zaktualizować stos
 
-		//stack_update(Frame);//Ramka została użyta, więc trzeba zaktualizować stos
+	tlb.insert(process->PID, pageID, entry.frame);
+	return entry.frame;
+}
 
-		response += RAM[Frame * 16 + address - 16 * PageID];
+void MemoryManager::copy_on_write(const shared_ptr<PCB>& process, int pageID) {
+	PageTableData& entry = PageTableArena[process->pageTable].at(pageID);
+	entry.cow = false;
+
+	//Pozostali właściciele zdążyli już się odłączyć - stronica jest prywatna
+	int& slot = entry.slot;
+	if (PageSlots[slot].references == 1) { return; }
+
+	//Kopia aktualnej zawartości stronicy - z ramki, jeśli stronica jest w pamięci RAM u dowolnego właściciela
+	//(proces mógł stracić ramkę przez zawieszenie, a zmiany pozostałych właścicieli są jeszcze tylko w ramce)
+	Page copy;
+	const int shared = PageSlots[slot].frame;
+	if (shared != -1) { memcpy(copy.data, &RAM[shared * 16], 16); }
+	else { load_slot(slot, copy.data); }
+	if (entry.bit) {
+		const int frame = entry.frame;
+		for (int owner = Frames[frame].owners; owner != -1; owner = Owners[owner].nextOwner) {
+			if (Owners[owner].PID == static_cast<int>(process->PID) && Owners[owner].pageID == pageID) { unmap_frame(owner); break; }
+		}
+		if (Frames[frame].owners == -1) { release_frame(frame); }
 	}
 
-	return response;
+	release_slot(slot);
+	slot = alloc_slot(copy);
+	tlb.invalidate_page(process->PID, pageID);
+
+	ProcessStats[process->PID].copies++;
+	GlobalStats.copies++;
 }
 
-int MemoryManager::write(const shared_ptr<PCB>& process, int address, string data) {
-	if (data.empty()) { return 1; }
+void MemoryManager::read_ahead(const shared_ptr<PCB>& process, int pageID) {
+	ReadAhead& state = Prefetch[process->PID];
 
-	if (address + data.length() - 1 > process->pageList->size() * 16 || address < 0) {
-		cout << "Error: Exceeded memory amount for this process! \n";
+	//Błąd niesekwencyjny - okno zaczyna się od nowa
+	if (pageID != state.lastPage + 1) {
+		state.lastPage = pageID;
+		state.window = 0;
+		return;
+	}
+	state.window = min(prefetchMax, state.window == 0 ? 1 : state.window * 2);
+	state.lastPage = pageID;
+
+	const int reserve = prefetchReserve == -1 ? static_cast<int>(Frames.size()) / 4 : prefetchReserve;
+	PagingStats& stats = ProcessStats[process->PID];
+	PageTable& pageList = PageTableArena[process->pageTable];
+	for (int page = pageID + 1; page <= pageID + state.window && page < static_cast<int>(pageList.size()); page++) {
+		//Nieużywane jeszcze stronice nie są sprowadzane - nie ma w nich kodu (brakujące węzły tablicy też nie są tworzone)
+		const PageTableData* next = pageList.find(page);
+		if (next == nullptr || next->slot == -1) break;
+		PageTableData& entry = pageList.at(page);
+		state.lastPage = page;
+		if (entry.bit) continue;
+
+		//Stronica jest już w pamięci u innego procesu - wystarczy ją dopisać do tablicy stronic
+		if (PageSlots[entry.slot].frame == -1) {
+			if (static_cast<int>(FreeFrames.size()) <= reserve || at_frame_limit(process->PID)) break;
+			entry.prefetched = true;
+			stats.prefetches++;
+			GlobalStats.prefetches++;
+		}
+		load_to_memory(entry.slot, page, process->PID, process->pageTable);
+	}
+}
+
+string MemoryManager::get_byte(const shared_ptr<PCB>& process, int address) {
+	char byte;
+	if (read(process, address, &byte, 1) == -1) { return "ERROR"; }
+	return string(1, byte);
+}
+
+int MemoryManager::read(const shared_ptr<PCB>& process, int address, char* out, size_t length, bool fetch) {
+	if (length == 0) { return 1; }
+
+	//przekroczenie zakres dla tego procesu
+	if (address < 0 || address + length > PageTableArena[process->pageTable].size() * 16) {
+		cout << "Error: Exceeded memory range!";
 		return -1;
 	}
 
-	//Aktualizacja pliku wymiany
-	{
-		int pageId = int(floor((address + 1) / 16.0));
+	//Odczyt fragmentami - każdy fragment mieści się w jednej stronicy
+	size_t done = 0;
+	while (done < length) {
+		const int pageID = (address + done) / 16;
+		const int offset = (address + done) % 16;
+		const size_t chunk = min(static_cast<size_t>(16 - offset), length - done);
+
+		const int frame = get_frame(process, pageID, false, fetch);
+		memcpy(out + done, &RAM[frame * 16 + offset], chunk);
+		Frames[frame].accesses++;
+		done += chunk;
+	}
 
-		int addressTemp = address;
-		for (unsigned int i = 0;; i++) {
-			PageFile[process->PID][pageId].data[addressTemp % 16] = data[i];
+	return 1;
+}
 
-			if (i == data.length() - 1) { break; }
-			addressTemp++;
-			if (addressTemp % 16 == 0) { pageId++; }
+int MemoryManager::write(const shared_ptr<PCB>& process, int address, string data) {
+	if (data.empty()) { return 1; }
 
-		}
+	if (address < 0 || address + data.length() > PageTableArena[process->pageTable].size() * 16) {
+		cout << "Error: Exceeded memory amount for this process! \n";
+		return -1;
 	}
 
-	for (size_t i = 0; i < data.length(); i++) {
-		const int pageID = int(floor((address + i) / 16.0));
-		if (process->pageList->at(pageID).bit == 0) {
-			load_to_memory(PageFile[process->PID][pageID], pageID, process->PID, process->pageList);
-		}
-		RAM[process->pageList->at(pageID).frame * 16 + address + i - (16 * pageID)] = data[i];
+	//Zapis fragmentami - każdy fragment mieści się w jednej stronicy
+	//Plik wymiany zostanie zaktualizowany dopiero przy usuwaniu ramki z pamięci
+	size_t done = 0;
+	while (done < data.length()) {
+		const int pageID = (address + done) / 16;
+		const int offset = (address + done) % 16;
+		const size_t chunk = min(static_cast<size_t>(16 - offset), data.length() - done);
+
+		const int frame = get_frame(process, pageID, true);
+		memcpy(&RAM[frame * 16 + offset], data.data() + done, chunk);
+		Frames[frame].dirty = true;
+		Frames[frame].accesses++;
+		mark_changed(frame);
+		done += chunk;
 	}
 	return 1;
 }
@@ -319,21 +1750,78 @@ int MemoryManager::write(const shared_ptr<PCB>& process, int address, string dat
 int MemoryManager::write_direct(int address, std::string data) {
 	for (size_t i = address; i < address + data.length(); i++) {
 		RAM[i] = data[i-address];
+		Frames[i / 16].dirty = true;
+		mark_changed(static_cast<int>(i / 16));
 	}
 	return 1;
 }
 
+bool MemoryManager::at_frame_limit(int PID) const {
+	const auto quota = Quotas.find(PID);
+	const auto stats = ProcessStats.find(PID);
+	return quota != Quotas.end() && quota->second.max > 0 && stats != ProcessStats.end() && stats->second.resident >= quota->second.max;
+}
+
+bool MemoryManager::replaces_own_frames(int PID) const {
+	if (at_frame_limit(PID)) { return true; }
+	if (!localReplacement) { return false; }
+
+	//Przy wymianie lokalnej proces bierze cudze ramki tylko, dopóki nie ma swojego minimum (co najmniej jednej ramki)
+	const auto stats = ProcessStats.find(PID);
+	const auto quota = Quotas.find(PID);
+	const int resident = stats == ProcessStats.end() ? 0 : stats->second.resident;
+	return resident >= max(quota == Quotas.end() ? 0 : quota->second.min, 1);
+}
+
+int MemoryManager::select_victim(int PID) const {
+	//Wymiana lokalna - najdawniej załadowana ramka procesu
+	if (replaces_own_frames(PID)) {
+		for (const int frame : Stack) {
+			for (int owner = Frames[frame].owners; owner != -1; owner = Owners[owner].nextOwner) {
+				if (Owners[owner].PID == PID) { return frame; }
+			}
+		}
+	}
+
+	//Wymiana globalna - pomijane są ramki, których zabranie zeszłoby poniżej minimum innego procesu
+	for (const int frame : Stack) {
+		if (Frames[frame].isFree) continue;
+		bool protectedFrame = false;
+		for (int owner = Frames[frame].owners; owner != -1; owner = Owners[owner].nextOwner) {
+			const int ownerPID = Owners[owner].PID;
+			const auto quota = Quotas.find(ownerPID);
+			if (ownerPID != PID && quota != Quotas.end() && ProcessStats.at(ownerPID).resident <= quota->second.min) {
+				protectedFrame = true;
+				break;
+			}
+		}
+		if (!protectedFrame) { return frame; }
+	}
+	return *Stack.begin();
+}
+
 int MemoryManager::insert_page(int pageID, int PID) {
 	//Numer ramki ktora jest ofiarą
-	const int Frame = *Stack.begin();
-	// Przepisuje zawartosc z ramki ofiary do pliku wymiany
-	for (int i = Frame * 16; i < Frame * 16 + 16; i++) {
-		PageFile[Frames[Frame].PID][Frames[Frame].pageID].data[i - (Frame * 16)] = RAM[i];
+	const int Frame = select_victim(PID);
+	FrameData& victim = Frames[Frame];
+	GlobalStats.evictions++; GlobalStats.resident--;
+
+	// Przepisuje zawartosc z ramki ofiary do pliku wymiany (tylko jeśli ramka była modyfikowana)
+	if (victim.dirty) {
+		page_out(victim.slot, &RAM[Frame * 16]);
+		ProcessStats[Owners[victim.owners].PID].writeBacks++;
+		GlobalStats.writeBacks++;
+	}
+	PageSlots[victim.slot].frame = -1;
+
+	//Zmieniam wartosci w tablicach stronic wszystkich procesów korzystających z ramki
+	while (victim.owners != -1) {
+		ProcessStats[Owners[victim.owners].PID].evictions++;
+		unmap_frame(victim.owners);
 	}
 
-	//Zmieniam wartosci w tablicy stronic ofiary
-	Frames[Frame].pageList->at(Frames[Frame].pageID).bit = false;
-	Frames[Frame].pageList->at(Frames[Frame].pageID).frame = -1;
+	//Tłumaczenia wskazujące na ramkę ofiary przestają być aktualne
+	tlb.invalidate_frame(Frame);
 
 	return Frame;
 }
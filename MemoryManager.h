@@ -2,10 +2,15 @@
 #ifndef SEXYOS_MEMORYMANGER_H
 #define SEXYOS_MEMORYMANGER_H
 #include <list>
+#include <array>
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 #include <memory>
+#include <functional>
+#include <fstream>
+#include <cstdint>
 
 class PCB;
 
@@ -14,16 +19,82 @@ class PCB;
 struct PageTableData {
 	bool bit;  //Wartość bool'owska sprawdzająca zajętość tablicy w pamięci [Sprawdza, czy ramka znajduje się w pamięci RAM]
 	int frame; //Numer ramki w której znajduje się stronica
+	bool zero = false; //Stronica nie była jeszcze używana (przy pierwszym załadowaniu wypełniana jest pustymi danymi)
+	bool cow = false; //Stronica współdzielona tylko do odczytu - pierwszy zapis tworzy prywatną kopię (copy-on-write)
+	bool shared = false; //Stronica segmentu pamięci współdzielonej - zapis jest widoczny we wszystkich procesach
+	bool prefetched = false; //Stronica sprowadzona z wyprzedzeniem, do której proces jeszcze się nie odwołał
+	int slot = -1; //Slot pliku stronicowania ze stronicą (-1 - stronica na żądanie, slot powstaje przy pierwszym dostępie)
 
 	PageTableData();
 	PageTableData(bool bit, int frame);
 };
 
+//------------- Wielopoziomowa tablica stronic -------------
+//Tablica płaska (1 poziom) trzyma wpis dla każdej stronicy procesu
+//Tablica wielopoziomowa (2 lub 3 poziomy) jest drzewem, którego węzły powstają dopiero przy pierwszym dostępie do stronicy
+//Dzięki temu rzadko używana, duża (przy 3 poziomach 31-bitowa) przestrzeń adresowa kosztuje tylko tyle, ile faktycznie używanych stronic
+class PageTable {
+private:
+	static const int LEAF_BITS = 6; //Liść obejmuje 64 stronice (1 KB przestrzeni adresowej)
+	static const int NODE_BITS = 8; //Węzeł pośredni (3 poziomy) i korzeń tablicy 2-poziomowej obejmują 256 węzłów niższego poziomu
+
+	//Węzły przechowywane są w jednym wektorze tablicy i wskazują na siebie indeksami (bez osobnej alokacji każdego węzła)
+	struct Node {
+		std::vector<int> children; //Indeksy węzłów niższego poziomu (-1 - węzeł jeszcze nie istnieje)
+		std::vector<PageTableData> entries; //Wpisy stronic (tylko w liściach)
+	};
+
+	int depth; //Ilość poziomów tablicy
+	size_t pages = 0; //Ilość stronic w przestrzeni adresowej procesu
+	std::vector<Node> Nodes; //Węzły tablicy, Nodes[0] to korzeń
+
+	//Zwraca liść ze stronicą (create - czy brakujące węzły mają zostać utworzone)
+	Node* leaf(int pageID, bool create);
+	const Node* leaf(int pageID) const;
+
+public:
+	//Ilość poziomów nowych tablic stronic (1 - płaska, 2 lub 3 - wielopoziomowa), ustawiana przy starcie systemu
+	static int defaultLevels;
+
+	explicit PageTable(int levels = defaultLevels);
+
+	//Czyści tablicę do ponownego użycia przez nowy proces (korzeń zachowuje zajętą pamięć)
+	void reset(int levels);
+
+	//Ilość stronic w przestrzeni adresowej procesu
+	size_t size() const;
+
+	//Powiększa przestrzeń adresową (nowe stronice są stronicami na żądanie, tablica nie może się zmniejszyć)
+	//@return false, gdy rozmiar przekracza max_address (tablica pozostaje bez zmian)
+	bool resize(size_t size);
+
+	//Zwraca wpis stronicy (w tablicy wielopoziomowej tworzy brakujące węzły), std::out_of_range poza przestrzenią adresową
+	PageTableData& at(int pageID);
+	PageTableData& operator[](int pageID);
+
+	//Zwraca wpis stronicy lub nullptr, jeśli węzeł z wpisem nie został jeszcze utworzony
+	const PageTableData* find(int pageID) const;
+
+	//Wywołuje funkcję dla każdego istniejącego wpisu (stronice w nieutworzonych węzłach są pomijane)
+	void for_each(const std::function<void(int, PageTableData&)>& visit);
+	void for_each(const std::function<void(int, const PageTableData&)>& visit) const;
+
+	int levels() const;
+	//Największy rozmiar przestrzeni adresowej procesu [B] (tablica płaska - 256 B, 2 poziomy - 256 KB, 3 poziomy - 31-bitowe adresy)
+	unsigned int max_address() const;
+	//Największy rozmiar przestrzeni adresowej dla danej ilości poziomów [B]
+	static unsigned int address_limit(int levels);
+	//Ilość utworzonych węzłów tablicy
+	size_t nodes() const;
+	//Przybliżony rozmiar tablicy w pamięci [B]
+	size_t bytes() const;
+};
+
 class MemoryManager {
 
 	//------------- Struktury używane przez MemoryManager'a oraz zmienne--------------
 public:
-	char RAM[256]; //Pamięć Fizyczna Komputera [256 bajtów]
+	std::vector<char> RAM; //Pamięć Fizyczna Komputera [domyślnie 256 bajtów - 16 ramek po 16 bajtów]
 private:
 	//------------- Struktura Pojedynczej Stronicy w Pamięci -------------
 	struct Page {
@@ -31,35 +102,343 @@ private:
 
 		Page();
 		explicit Page(std::string data);
+		//Stronica z fragmentu bufora (krótszy fragment uzupełniany jest spacjami)
+		Page(const char* data, size_t length);
 
 		void print() const;
 	};
 
+	//------------- Slot pliku stronicowania -------------
+	//Informacje o stronicy przechowywanej w pliku stronicowania (sama zawartość znajduje się w magazynie slotów)
+	struct PageSlot {
+		int references = 0; //Ilość procesów, których tablice stronic korzystają z tej stronicy
+		int frame = -1; //Ramka, w której znajduje się kopia stronicy (-1 gdy stronicy nie ma w pamięci RAM)
+		int offset = -1; //Położenie skompresowanej zawartości w puli (tylko skompresowany plik stronicowania)
+		unsigned char length = 0; //Długość skompresowanej zawartości (0 - stronica wypełniona jednym znakiem)
+		char fill = ' '; //Znak wypełniający stronicę, gdy length == 0
+		int disk = -1; //Miejsce stronicy w obszarze wymiany na dysku FileManagera (-1 - stronica nie jest na dysku)
+	};
+
+	//------------- Właściciel ramki -------------
+	//Proces, w którego tablicy stronic znajduje się dana ramka (ramka współdzielona ma kilku właścicieli)
+	//Wpisy właścicieli leżą w jednej puli i są połączone indeksami w dwie listy:
+	//listę właścicieli ramki oraz listę ramek zajmowanych przez proces (obsługa błędu stronicy niczego nie alokuje)
+	struct FrameOwner {
+		int PID; //Numer Procesu
+		int pageID; //Numer stronicy w tablicy stronic procesu
+		int table; //Indeks tablicy stronic procesu w puli tablic stronic
+		int frame; //Numer ramki
+		int nextOwner = -1; //Następny właściciel tej samej ramki (-1 - koniec listy)
+		int prevResident = -1; //Poprzednia ramka tego samego procesu (-1 - początek listy)
+		int nextResident = -1; //Następna ramka tego samego procesu (-1 - koniec listy)
+	};
+	std::vector<FrameOwner> Owners; //Pula wpisów właścicieli ramek
+	std::vector<int> FreeOwners; //Zwolnione wpisy do ponownego użycia
+
 	//------------- Lista Ramek -------------
 	//Struktura wykorzystywana do lepszego przeszukiwania pamięci ram i łatwiejszej wymiany stronic
 	struct FrameData {
-		bool isFree; //Czy ramka jest wolna (True == wolna, False == zajęta)
-		int PID; //Numer Procesu
-		int pageID; //Numer stronicy
-		std::shared_ptr<std::vector<PageTableData>> pageList; //Wskaźnik do tablicy stronic procesu, która znajduje się w PCB
-
-		FrameData(bool isFree, int PID, int pageID, std::vector<PageTableData> *pageList);
+		bool isFree = true; //Czy ramka jest wolna (True == wolna, False == zajęta)
+		int slot = -1; //Numer slotu pliku stronicowania, którego kopia znajduje się w ramce
+		int owners = -1; //Pierwszy właściciel ramki w puli właścicieli (-1 - ramka nie ma właściciela)
+		int ownerCount = 0; //Ilość procesów, które korzystają z ramki
+		bool dirty = false; //Czy zawartość ramki była modyfikowana od załadowania (wtedy trzeba ją zapisać do pliku wymiany)
+		std::list<int>::iterator stackPosition; //Pozycja ramki na stosie wymiany (aktualizacja w czasie stałym)
+		unsigned long long accesses = 0; //Ilość odwołań do ramki (odczyty i zapisy) od wyzerowania liczników
+		unsigned long long generation = 0; //Pokolenie, w którym zawartość ramki zmieniła się ostatni raz
 	};
 
 	//------------- Ramki załadowane w Pamięci Fizycznej [w pamięci RAM]-------------
 	std::vector<FrameData> Frames;
 
+	//------------- Pokolenia zmian zawartości ramek -------------
+	//Każda zmiana zawartości ramki zapisuje w niej bieżące pokolenie, a wyświetlenie pamięci rozpoczyna nowe
+	//Widok różnic wypisuje tylko ramki z pokoleniem nowszym niż ostatnio wyświetlone
+	unsigned long long memoryGeneration = 1;
+	unsigned long long shownGeneration = 0; //Pokolenie ostatnio wyświetlonego stanu pamięci
+
+	//------------- Wolne ramki -------------
+	//Numery wolnych ramek, jako pierwsza wybierana jest ramka o najmniejszym numerze
+	std::set<int> FreeFrames;
+
+	//------------- Ramki zajmowane przez procesy -------------
+	// map < PID procesu, Pierwszy i ostatni wpis listy ramek procesu w puli właścicieli>
+	//Dzięki tej liście usuwanie procesu dotyka tylko jego ramek zamiast przeszukiwać całą pamięć
+	struct ResidentList {
+		int first = -1;
+		int last = -1;
+	};
+	std::map<int, ResidentList> ResidentFrames;
+
 	//------------- Plik stronicowania -------------
-	// map < PID procesu, Stronice danego procesu>
-	std::map<int, std::vector<Page>> PageFile;
-	//std::vector<std::pair<int, std::vector<Page>>> PageFile;
+	//Stronice przechowywane są w slotach, a numer slotu każdej stronicy zapisany jest w tablicy stronic procesu
+	//Jeden slot może należeć do kilku procesów (np. po forku copy-on-write) - pilnuje tego licznik referencji stronicy
+	std::vector<PageSlot> PageSlots;
+	std::vector<int> FreeSlots; //Zwolnione sloty do ponownego użycia
+	//------------- Tablice stronic -------------
+	//Tablice stronic wszystkich procesów leżą w jednej puli, a PCB i właściciele ramek wskazują je indeksem
+	//Tablica zakończonego procesu wraca na listę wolnych i jest używana przez kolejny proces
+	//Nieużywana jeszcze stronica (na żądanie) ma slot -1 - slot wypełniony pustymi danymi powstaje przy pierwszym dostępie
+	std::vector<PageTable> PageTableArena;
+	std::vector<int> FreePageTables;
+	// map < PID procesu, Indeks tablicy stronic procesu w puli>
+	std::map<int, int> PageTables;
+	// map < PID procesu, Sloty programu wczytanego przez load_program>
+	//Sloty czekają tu, aż create_page_list wpisze je do nowej tablicy stronic procesu
+	std::map<int, std::vector<int>> ProgramSlots;
+
+	//------------- Plik wymiany na dysku -------------
+	//Plik na dysku gospodarza zmapowany do pamięci - slot o numerze n zajmuje bajty [16n, 16n + 16)
+	//Pozwala symulować więcej pamięci wirtualnej niż ma gospodarz, a po zakończeniu pracy plik można przejrzeć
+	class SwapFile {
+	private:
+		std::string path; //Ścieżka do pliku
+		char* view = nullptr; //Zmapowana zawartość pliku
+		size_t capacity = 0; //Ilość slotów mieszczących się w zmapowanym pliku
+#ifdef _WIN32
+		void* file = nullptr; //Uchwyt pliku
+		void* mapping = nullptr; //Uchwyt odwzorowania pliku
+#else
+		int descriptor = -1; //Deskryptor pliku
+#endif
+
+		bool map(size_t slots);
+		void unmap();
+
+	public:
+		//Tworzy (nadpisuje) plik i mapuje go do pamięci
+		bool open(const std::string& path, size_t slots);
+		//Powiększa plik tak, aby mieścił podaną ilość slotów (plik jest mapowany ponownie, przy błędzie zostaje dotychczasowe odwzorowanie)
+		bool reserve(size_t slots);
+		void close();
+
+		bool is_open() const;
+		const std::string& name() const;
+		size_t size() const;
+		char* slot(int slot) const;
+
+		~SwapFile();
+	} swapFile;
+
+	//Zawartość slotów, gdy plik stronicowania znajduje się w pamięci (bez pliku wymiany)
+	std::vector<char> SlotMemory;
+
+	//------------- Skompresowany plik stronicowania -------------
+	//Zamiast 16 bajtów na slot w puli trzymana jest skompresowana zawartość stronicy (podobnie jak zram)
+	//Stronice wypełnione jednym znakiem (np. same spacje) nie zajmują w puli miejsca
+	bool compressedSwap = false;
+	std::vector<char> CompressedPool;
+	size_t poolGarbage = 0; //Bajty puli z nieaktualną zawartością (odzyskiwane przy kompaktowaniu)
+
+	struct CompressionStats {
+		unsigned long long compressions = 0; //Ilość skompresowanych stronic
+		unsigned long long decompressions = 0; //Ilość rozpakowanych stronic
+		unsigned long long compressNs = 0; //Łączny czas kompresji [ns]
+		unsigned long long decompressNs = 0; //Łączny czas dekompresji [ns]
+	} Compression;
+
+	//------------- Obszar wymiany na dysku systemu plików -------------
+	//Wyrzucane z pamięci RAM zmodyfikowane stronice zapisywane są w blokach dysku zarezerwowanych u FileManagera
+	//Zapis i odczyt takich stronic to operacje dyskowe, które konkurują z operacjami na plikach
+	bool diskSwap = false;
+	int diskSwapLimit = 8; //Największa ilość bloków dysku, którą może zająć obszar wymiany
+	std::vector<unsigned int> SwapBlocks; //Zarezerwowane bloki dysku
+	std::vector<int> FreeDiskSlots; //Wolne miejsca na stronice w obszarze wymiany (blok * stronic_w_bloku + indeks)
+
+	struct DiskSwapStats {
+		unsigned long long pageOuts = 0; //Stronice zapisane do obszaru wymiany
+		unsigned long long pageIns = 0; //Stronice odczytane z obszaru wymiany
+		unsigned long long overflows = 0; //Zapisy, dla których zabrakło miejsca w obszarze wymiany (stronica została w pliku stronicowania)
+	} DiskSwap;
+
+	//------------- Plik z programem -------------
+	//Zawartość pliku programu dostępna jako jeden bufor - mały plik jest wczytywany jednym odczytem,
+	//a duży (od MAP_THRESHOLD bajtów) mapowany do pamięci tylko do odczytu, bez kopiowania
+	class ProgramFile {
+	private:
+		std::vector<char> buffer; //Wczytana zawartość małego pliku
+		const char* view = nullptr; //Początek zawartości (bufor albo zmapowany plik)
+		size_t length = 0; //Rozmiar pliku
+		bool mapped = false; //Czy plik jest zmapowany
+#ifdef _WIN32
+		void* file = nullptr; //Uchwyt pliku
+		void* mapping = nullptr; //Uchwyt odwzorowania pliku
+#endif
+
+	public:
+		static const size_t MAP_THRESHOLD = 64 * 1024;
+
+		//Otwiera plik i udostępnia jego zawartość (False, gdy pliku nie da się otworzyć)
+		bool open(const std::string& path);
+		void close();
+
+		const char* data() const;
+		size_t size() const;
+		bool is_mapped() const;
+
+		~ProgramFile();
+	};
+
+	//------------- Obrazy programów -------------
+	//Stronice kodu ładowane są raz, a procesy uruchomione z tego samego programu współdzielą je (copy-on-write)
+	//Obraz trzyma własną referencję do slotów, dopóki działa choć jeden proces uruchomiony z tego programu
+	struct ProgramImage {
+		std::vector<int> slots; //Sloty ze stronicami kodu programu
+		int users = 0; //Ilość działających procesów uruchomionych z obrazu
+	};
+	//Obraz identyfikowany jest ścieżką pliku i skrótem wczytanej treści (zmieniony plik daje nowy obraz)
+	typedef std::pair<std::string, size_t> ImageKey;
+	std::map<ImageKey, ProgramImage> ProgramImages;
+	// map < PID procesu, Obraz, z którego proces został uruchomiony>
+	std::map<int, ImageKey> ProcessImages;
+
+	//------------- Segmenty pamięci współdzielonej -------------
+	//Nazwany segment składa się ze slotów pliku stronicowania dołączanych do tablic stronic kilku procesów
+	struct SharedSegment {
+		std::vector<int> slots; //Sloty ze stronicami segmentu (segment trzyma własną referencję do każdego z nich)
+		std::set<int> attached; //Procesy, do których przestrzeni adresowej segment jest dołączony
+	};
+	// map < Nazwa segmentu, Segment>
+	std::map<std::string, SharedSegment> Segments;
+
+	//------------- Tryb forka -------------
+	//True - dziecko współdzieli stronice i ramki rodzica do pierwszego zapisu, False - wszystkie stronice są kopiowane
+	bool copyOnWriteFork = true;
+
+	//------------- Limity ramek procesów -------------
+	//Minimum - ramki, których nie mogą odebrać procesowi inne procesy, maksimum - ramki, powyżej których proces wymienia własne stronice
+	struct FrameQuota {
+		int min = 0; //Gwarantowana ilość ramek
+		int max = 0; //Największa ilość ramek (0 - bez limitu)
+	};
+	std::map<int, FrameQuota> Quotas; //Limity ramek poszczególnych procesów (klucz - PID)
+
+	//------------- Tryb wymiany stronic -------------
+	//False - wymiana globalna (ofiarą może być ramka dowolnego procesu), True - wymiana lokalna (ofiara wybierana z ramek procesu, który spowodował błąd)
+	bool localReplacement = false;
 
 	//------------- Stos ostatnio używanych ramek (Least Recently Used Stack) -------------
 	//Stos dzięki, którem wiemy, która ramka jest najdłużej w pamięci i którą ramkę możemy zastąpić
-	//Jako, że mamy 256B pamięci ram, a jedna ramka posiada 16B, to będziemy mieć łącznie 16 ramek [0-15]
+	//Jako, że domyślnie mamy 256B pamięci ram, a jedna ramka posiada 16B, to będziemy mieć łącznie 16 ramek [0-15]
 	//Więcej: https://pl.wikipedia.org/wiki/Least_Recently_Used
-	std::list<int> Stack{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+	std::list<int> Stack;
+
+	//------------- Bufor TLB (Translation Lookaside Buffer) -------------
+	//Mała, zbiorowo-skojarzeniowa pamięć podręczna tłumaczeń (PID, stronica) -> ramka
+	//Może być opróżniana przy każdym przełączeniu kontekstu albo oznaczać wpisy numerem procesu (ASID)
+	class TLB {
+	private:
+		struct Entry {
+			bool valid = false; //Czy wpis jest ważny
+			int PID = -1; //Numer procesu (znacznik ASID)
+			int pageID = -1; //Numer stronicy
+			int frame = -1; //Numer ramki
+			unsigned long long lastUse = 0; //Czas ostatniego użycia (LRU w obrębie zbioru)
+		};
+
+		std::vector<Entry> entries;
+		int ways = 2; //Stopień skojarzeniowości (ilość wpisów w zbiorze)
+		int sets = 4; //Ilość zbiorów
+		bool tagged = false; //True - wpisy oznaczone PID (ASID), False - opróżnianie przy przełączeniu kontekstu
+		int currentPID = -1; //Proces, którego tłumaczenia są obecnie w buforze
+		unsigned long long clock = 0;
+
+	public:
+		unsigned long long hits = 0;
+		unsigned long long misses = 0;
+		unsigned long long flushes = 0;
+
+		TLB();
+
+		//Zmienia konfigurację bufora (zeruje zawartość i statystyki)
+		/* size - ilość wpisów
+		 * ways - stopień skojarzeniowości
+		 * tagged - czy wpisy mają być oznaczone PID
+		 * @return int 1 przy powodzeniu, -1 przy błędnych parametrach
+		 */
+		int configure(int size, int ways, bool tagged);
+
+		//Informuje bufor, że tłumaczenia wykonuje proces PID (bez ASID oznacza to opróżnienie bufora)
+		void switch_to(int PID);
+
+		//Zwraca numer ramki dla stronicy lub -1, jeśli tłumaczenia nie ma w buforze
+		int lookup(int PID, int pageID);
+
+		//Dodaje tłumaczenie do bufora (zastępując najdawniej używany wpis w zbiorze)
+		void insert(int PID, int pageID, int frame);
+
+		//Unieważnia wpisy wskazujące na daną ramkę (np. po jej zastąpieniu)
+		void invalidate_frame(int frame);
+
+		//Unieważnia wpis danej stronicy procesu
+		void invalidate_page(int PID, int pageID);
+
+		//Unieważnia wszystkie wpisy danego procesu
+		void invalidate_process(int PID);
+
+		//Unieważnia całą zawartość bufora
+		void flush();
+
+		void print() const;
+	} tlb;
+
+	//------------- Statystyki stronicowania -------------
+	//Liczniki zdarzeń pamięci wirtualnej prowadzone dla każdego procesu oraz dla całego systemu
+	struct PagingStats {
+		static const int WINDOW = 32; //Ilość ostatnich rozkazów, z których liczona jest częstość błędów stronicy
+
+		unsigned long long faults = 0; //Błędy stronicy (sprowadzenia stronicy na żądanie)
+		unsigned long long evictions = 0; //Stronice usunięte z pamięci RAM przez algorytm wymiany
+		unsigned long long writeBacks = 0; //Zapisy brudnych ramek do pliku wymiany
+		unsigned long long zeroFills = 0; //Pierwsze załadowania nieużywanych jeszcze stronic
+		unsigned long long copies = 0; //Prywatne kopie stronic współdzielonych utworzone przy zapisie (copy-on-write)
+		unsigned long long prefetches = 0; //Stronice sprowadzone z wyprzedzeniem
+		unsigned long long prefetchHits = 0; //Stronice sprowadzone z wyprzedzeniem, które zostały potem użyte
+		unsigned long long prefetchMisses = 0; //Stronice sprowadzone z wyprzedzeniem i usunięte z pamięci bez użycia
+		int resident = 0; //Ilość ramek zajmowanych obecnie w pamięci RAM
+
+		//Ilość błędów stronicy w każdym z ostatnich rozkazów - bufor cykliczny (bez alokacji przy każdym rozkazie)
+		std::array<int, WINDOW> window{};
+		int windowHead = 0; //Miejsce następnego wpisu (przy pełnym oknie - najstarszy wpis)
+		int windowCount = 0; //Ilość rozkazów w oknie (do WINDOW)
+		int windowFaults = 0; //Suma błędów w oknie
+		int pendingFaults = 0; //Błędy w bieżącym (jeszcze niezakończonym) rozkazie
+
+		//Zamyka bieżący rozkaz i przesuwa okno
+		void instruction();
+		//Średnia ilość błędów stronicy na rozkaz w oknie
+		double fault_rate() const;
+		void print() const;
+	};
 
+	PagingStats GlobalStats; //Statystyki całego systemu
+	std::map<int, PagingStats> ProcessStats; //Statystyki poszczególnych procesów (klucz - PID)
+
+	//------------- Sprowadzanie stronic z wyprzedzeniem (read-ahead) -------------
+	//Kod programu leży w kolejnych stronicach, więc kolejne błędy stronicy przy pobieraniu rozkazów są zwykle sekwencyjne
+	//Po wykryciu takiego ciągu sprowadzane są następne stronice, a okno rośnie dwukrotnie (do prefetchMax stronic)
+	struct ReadAhead {
+		int lastPage = 0; //Ostatnia stronica sprowadzona przy pobieraniu rozkazów (stronica 0 ładowana jest przy tworzeniu procesu)
+		int window = 0; //Ilość stronic sprowadzanych z wyprzedzeniem przy kolejnym sekwencyjnym błędzie
+	};
+	std::map<int, ReadAhead> Prefetch; //Stan sprowadzania z wyprzedzeniem poszczególnych procesów (klucz - PID)
+	int prefetchMax = 4; //Największe okno (0 wyłącza sprowadzanie z wyprzedzeniem)
+	int prefetchReserve = -1; //Ilość wolnych ramek, których nie wolno zająć z wyprzedzeniem (-1 - ćwierć pamięci)
+
+
+	//------------- Ślad odwołań do pamięci -------------
+	//Każde odwołanie do stronicy (PID, stronica, odczyt/zapis) może być zapisywane do binarnego pliku śladu
+	//Ślad odtwarza narzędzie tools/trace_sim.cpp dla dowolnej ilości ramek i algorytmów wymiany (bez ponownego uruchamiania systemu)
+	//Plik: nagłówek "SXTR", wersja, ilość ramek, rozmiar stronicy (4 x uint32), potem rekordy po 8 bajtów
+	struct TraceRecord {
+		std::uint32_t PID; //Numer procesu
+		std::uint32_t access; //Numer stronicy przesunięty o 1 bit, najmłodszy bit - zapis (1) lub odczyt (0)
+	};
+	static const size_t TRACE_BUFFER = 4096; //Ilość rekordów zbieranych w pamięci przed zapisem do pliku
+	std::ofstream traceFile;
+	std::string tracePath;
+	std::vector<TraceRecord> TraceBuffer;
+	unsigned long long traceRecords = 0; //Ilość rekordów zapisanych od rozpoczęcia śladu
 
 	//------------- Funkcje do wyświetlania bieżących stanów pamięci oraz pracy krokowej  --------------
 public:
@@ -72,13 +451,28 @@ public:
 	 */
 	void show_memory(int begin, int bytes);
 
+	//Pokazuje tylko ramki, których zawartość zmieniła się od ostatniego wyświetlenia pamięci
+	void show_memory_diff();
+
+	//Pokazuje mapę cieplną ramek - ilość odwołań do każdej ramki w skali od '.' (brak) do '#' (najczęściej używana)
+	void show_heatmap() const;
+
+	//Zeruje liczniki odwołań do ramek
+	void reset_heatmap();
+
 	//Pokazuje zawartość pliku stronicowania
 	void show_page_file() const;
 
 	//Pokazuje zawartość tablicy wymiany processu
-	/* pageList - wskaźnik na tablicę stronic procesu
+	/* table - indeks tablicy stronic procesu (z PCB)
 	 */
-	static void show_page_table(const std::shared_ptr<std::vector<PageTableData>>& pageList);
+	void show_page_table(int table) const;
+
+	//Ustawia ilość poziomów tablic stronic procesów tworzonych od tej chwili
+	/* levels - 1: tablica płaska, 2 lub 3: tablica wielopoziomowa
+	 * @return int 1 przy powodzeniu, -1 przy błędnej ilości poziomów
+	 */
+	static int set_page_table_levels(int levels);
 
 	//Pokazuje Stos ostatnio używanych ramek
 	void show_stack();
@@ -86,28 +480,169 @@ public:
 	//Pokazuje listę ramek w pamięci wraz z informacją do kogo dana ramka należy
 	void show_frames();
 
+	//Pokazuje zawartość i statystyki bufora TLB (trafienia, chybienia, opróżnienia)
+	void show_tlb() const;
+
+	//Zmienia konfigurację bufora TLB
+	/* size - ilość wpisów
+	 * ways - stopień skojarzeniowości
+	 * tagged - True: wpisy oznaczone PID (ASID), False: opróżnianie przy przełączeniu kontekstu
+	 */
+	int set_tlb(int size, int ways, bool tagged);
+
+	//Pokazuje segmenty pamięci współdzielonej wraz z procesami, do których są dołączone
+	void show_segments() const;
+
+	//Pokazuje, gdzie znajduje się zawartość pliku stronicowania (pamięć lub plik na dysku) i ile zajmuje
+	void show_swap_file() const;
+
+	//Przenosi zawartość pliku stronicowania do pliku na dysku zmapowanego do pamięci
+	/* path - ścieżka do pliku (pusta - powrót do pliku stronicowania w pamięci)
+	 * @return int 1 przy powodzeniu, -1 gdy pliku nie udało się utworzyć lub zmapować
+	 */
+	int set_swap_file(const std::string& path);
+
+	//Pokazuje stan obszaru wymiany na dysku oraz liczniki operacji dyskowych
+	void show_disk_swap() const;
+
+	//Włącza lub wyłącza obszar wymiany na dysku systemu plików (niedostępny razem z kompresją pliku stronicowania)
+	/* enable - True: wyrzucane zmodyfikowane stronice trafiają na dysk, False: stronice z dysku wracają do pliku stronicowania
+	 * blocks - największa ilość bloków dysku dla obszaru wymiany
+	 * @return int 1 przy powodzeniu, -1 przy błędnych parametrach albo włączonej kompresji
+	 */
+	int set_disk_swap(bool enable, int blocks);
+
+	//Pokazuje stan skompresowanego pliku stronicowania (stopień kompresji, czasy kompresji i dekompresji)
+	void show_compression() const;
+
+	//Włącza lub wyłącza kompresję pliku stronicowania (niedostępna razem z plikiem wymiany na dysku)
+	/* enable - True: zawartość slotów jest kompresowana, False: sloty przechowywane bez kompresji
+	 * @return int 1 przy powodzeniu, -1 gdy używany jest plik wymiany na dysku
+	 */
+	int set_compression(bool enable);
+
+	//Pokazuje ustawienia oraz trafienia i chybienia sprowadzania stronic z wyprzedzeniem
+	void show_prefetch() const;
+
+	//Zmienia ustawienia sprowadzania stronic z wyprzedzeniem
+	/* maxPages - największe okno (0 wyłącza sprowadzanie z wyprzedzeniem)
+	 * reserve - ilość wolnych ramek, które muszą pozostać wolne (stronice innych procesów nie są usuwane)
+	 * @return int 1 przy powodzeniu, -1 przy błędnych parametrach
+	 */
+	int set_prefetch(int maxPages, int reserve);
+
+	//Pokazuje tryb wymiany stronic oraz limity ramek, ilość zajmowanych ramek i częstość błędów stronicy procesów
+	void show_frame_quotas() const;
+
+	//Ustawia limity ramek procesu
+	/* PID - ID procesu
+	 * minFrames - ilość ramek, których nie mogą odebrać procesowi inne procesy
+	 * maxFrames - największa ilość ramek procesu (0 - bez limitu)
+	 * @return int 1 przy powodzeniu, -1 przy błędnych limitach (suma minimów musi zostawić wolną ramkę)
+	 */
+	int set_frame_quota(int PID, int minFrames, int maxFrames);
+
+	//Ustawia tryb wymiany stronic (True - lokalna, False - globalna)
+	void set_local_replacement(bool local);
+
+	//Zwraca tryb wymiany stronic (True - lokalna)
+	bool get_local_replacement() const;
+
+	//Pokazuje, czy zapisywany jest ślad odwołań do pamięci i ile rekordów zawiera
+	void show_trace() const;
+
+	//Rozpoczyna lub kończy zapis śladu odwołań do pamięci
+	/* path - ścieżka do pliku śladu (pusta - zakończenie zapisu)
+	 * @return int 1 przy powodzeniu, -1 gdy pliku nie udało się utworzyć lub ślad jest już zapisywany
+	 */
+	int set_trace(const std::string& path);
+
+	//Pokazuje statystyki stronicowania całego systemu oraz wszystkich procesów
+	void show_stats() const;
+
+	//Pokazuje statystyki stronicowania wybranego procesu
+	void show_stats(int PID) const;
+
+	//Informuje o wykonaniu rozkazu przez proces (przesuwa okno częstości błędów stronicy)
+	void count_instruction(int PID);
+
+	//Średnia ilość błędów stronicy na rozkaz w ostatnim oknie (całego systemu)
+	double fault_rate() const;
+
+	//Ilość wolnych ramek pamięci RAM
+	int free_frames() const;
+
 	//------------- Funkcje użytkowe MemoryManagera  --------------
 
 			//Tworzy proces bezczynności systemu umieszczany w pamięci RAM przy starcie systemu
 	void memory_init();
 
 	//Metoda ładująca program do pliku wymiany
+	//Plik czytany jest raz - z jednego przejścia po jego zawartości powstaje program w jednej linii i stronice kodu
 	/* path - ścieżka do programu na dysku twardym
 	 * PID - ID procesu
+	 * program - tu trafia program w jednej linii (rozkazy zakończone ';'), np. do oszacowania czasu wykonania
+	 * @return int długość programu w bajtach albo -1, gdy pliku nie udało się otworzyć
 	 */
-	int load_program(const std::string& path, int PID);
+	int load_program(const std::string& path, int PID, std::string& program);
 
 	//Usuwa z pamięci dane wybranego procesu
 	void kill(int PID);
 
-	//Tworzy wskaźnik do tablicy stronic danego procesu - funkcja wywoływana przy tworzeniu procesu
+	//Usuwa z pamięci RAM wszystkie stronice procesu (zawieszenie procesu przez swapper)
+	//Brudne ramki trafiają do pliku stronicowania, a stronice wracają do pamięci na żądanie po wznowieniu procesu
+	/*  PID - ID procesu
+	 * @return int ilość ramek zajmowanych przez proces (rozmiar jego zbioru roboczego)
+	 */
+	int swap_out(int PID);
+
+	//Tworzy tablicę stronic danego procesu - funkcja wywoływana przy tworzeniu procesu
 	/*  mem - potrzebna ilość pamięci
 	 *  PID - ID procesu
+	 * @return int indeks tablicy stronic w puli (zapisywany w PCB), -1 gdy proces przekracza przestrzeń adresową
 	 */
-	std::shared_ptr<std::vector<PageTableData>> create_page_list(int mem, int PID);
+	int create_page_list(int mem, int PID);
 
 	//Zmienia rozmiar tablicy stronic (ma tylko zwiększać)
-	void resize_page_list(int size, PCB* proc);
+	//@return int 1 - rozmiar zmieniony, -1 - rozmiar przekracza przestrzeń adresową (proces bez zmian)
+	int resize_page_list(int size, PCB* proc);
+
+	//Tworzy tablicę stronic dziecka powstającego przez fork procesu rodzica
+	//W trybie copy-on-write dziecko współdzieli stronice i ramki rodzica aż do pierwszego zapisu
+	/*  parent - wskaźnik do PCB rodzica
+	 *  PID - ID procesu dziecka
+	 * @return int indeks tablicy stronic dziecka w puli
+	 */
+	int fork_page_list(const std::shared_ptr<PCB>& parent, int PID);
+
+	//Zwraca tablicę stronic z puli (referencja jest ważna do utworzenia kolejnej tablicy)
+	/*  table - indeks tablicy stronic (z PCB)
+	 */
+	PageTable& page_table(int table);
+	const PageTable& page_table(int table) const;
+
+	//Ustawia tryb forka (True - copy-on-write, False - kopiowanie wszystkich stronic)
+	void set_fork_mode(bool copyOnWrite);
+
+	//Zwraca tryb forka (True - copy-on-write)
+	bool get_fork_mode() const;
+
+	//Tworzy nazwany segment pamięci współdzielonej
+	/*  name - nazwa segmentu
+	 *  size - rozmiar segmentu w bajtach (zaokrąglany w górę do całych stronic)
+	 * @return int 1 gdy segment został utworzony, 0 gdy już istniał, -1 przy błędnym rozmiarze
+	 */
+	int shm_get(const std::string& name, int size);
+
+	//Dołącza segment na koniec przestrzeni adresowej procesu (bez kopiowania - procesy widzą te same ramki)
+	/*  process - wskaźnik do PCB procesu
+	 *  name - nazwa segmentu
+	 * @return int adres logiczny początku segmentu w procesie lub -1, gdy segmentu nie ma, jest już dołączony albo nie mieści się w przestrzeni adresowej
+	 */
+	int shm_attach(const std::shared_ptr<PCB>& process, const std::string& name);
+
+	//Odłącza od procesu wszystkie segmenty, segment bez procesów zostaje usunięty (wywoływane przy zabijaniu procesu)
+	void shm_detach_all(int PID);
 
 	//Pobiera bajt z danego adresu
 	/* std::shared_ptr<PCB> process - wskaźnik do PCB danego procesu
@@ -115,7 +650,19 @@ public:
 	*/
 	std::string get_byte(const std::shared_ptr<PCB>& process, int address);
 
-	//Zapisuje dany fragment do pamięci w pliku wymiany
+	//Pobiera ciąg bajtów zaczynając od danego adresu
+	//Adres tłumaczony jest raz na każdy fragment stronicy, stronice sprowadzane są w kolejności adresów
+	/* std::shared_ptr<PCB> process - wskaźnik do PCB danego procesu
+	 * int address - adres logiczny od którego zaczynamy odczyt
+	 * char* out - bufor do którego zostaną przepisane bajty
+	 * size_t length - ilość bajtów do odczytania
+	 * bool fetch - odczyt rozkazu przez interpreter (sekwencyjne błędy stronicy uruchamiają sprowadzanie z wyprzedzeniem)
+	 * @return int zwraca 1 przy powodzeniu, -1 przy przekroczeniu zakresu
+	 */
+	int read(const std::shared_ptr<PCB>& process, int address, char* out, size_t length, bool fetch = false);
+
+	//Zapisuje dany fragment do pamięci procesu (jednym przejściem po fragmentach stronic)
+	//Zmodyfikowane ramki są oznaczane jako brudne i trafiają do pliku wymiany przy ich zastąpieniu
 	/* *process - wskaźnik do PCB danego procesu
 	 * address - adres logiczny w pamięci na którym chemy coś zapisać
 	 * data - dane do zapisania w pamięci - np. dane z rejestru
@@ -140,13 +687,108 @@ private:
 	 */
 	void stack_update(int frameID);
 
+	//Oznacza zmianę zawartości ramki w bieżącym pokoleniu (dla widoku różnic pamięci)
+	void mark_changed(int frame);
+
+	//Wypisuje zawartość jednej ramki w wierszu "Frame no.X:"
+	void print_frame(int frame) const;
+
 	//Ładuje daną stronicę do pamięci RAM
-	/*  page - stronica do załadowania
+	//Jeśli stronica jest już w pamięci (współdzielona z innym procesem), ramka zostaje tylko dopisana do tablicy stronic
+	/*  slot - slot pliku stronicowania ze stronicą do załadowania
 	 *  pageID - numer stronicy
 	 *  PID - numer procesu
-	 *  *pageList - wskaźnik na tablicę stronic procesu
+	 *  table - indeks tablicy stronic procesu
 	 */
-	int load_to_memory(Page page, int pageID, int PID, const std::shared_ptr<std::vector<PageTableData>>& pageList);
+	int load_to_memory(int slot, int pageID, int PID, int table);
+
+	//Zwraca numer ramki, w której znajduje się stronica procesu (w razie potrzeby sprowadza ją do pamięci RAM)
+	/*  process - wskaźnik do PCB procesu
+	 *  pageID - numer stronicy
+	 *  write - czy ramka jest potrzebna do zapisu (stronica copy-on-write zostanie skopiowana)
+	 *  fetch - czy ramka jest potrzebna do pobrania rozkazu (możliwe sprowadzenie kolejnych stronic z wyprzedzeniem)
+	 */
+	int get_frame(const std::shared_ptr<PCB>& process, int pageID, bool write = false, bool fetch = false);
+
+	//Sprowadza z wyprzedzeniem stronice następujące po stronicy, przy której wystąpił sekwencyjny błąd
+	//Używa tylko wolnych ramek ponad rezerwę, więc nie usuwa z pamięci stronic innych procesów
+	void read_ahead(const std::shared_ptr<PCB>& process, int pageID);
+
+	//Tworzy prywatną kopię współdzielonej stronicy procesu (pierwszy zapis do stronicy copy-on-write)
+	void copy_on_write(const std::shared_ptr<PCB>& process, int pageID);
+
+	//Dopisuje ramkę do tablicy stronic procesu
+	void map_frame(int frame, int pageID, int PID, int table);
+
+	//Usuwa ramkę z tablicy stronic jednego z jej właścicieli
+	/*  owner - indeks wpisu właściciela w puli właścicieli
+	 */
+	void unmap_frame(int owner);
+
+	//Odłącza wpis właściciela od listy właścicieli ramki i listy ramek procesu, wpis wraca do puli
+	void release_owner(int owner);
+
+	//Zajmuje tablicę stronic w puli (zwolnioną przez zakończony proces albo nową)
+	int alloc_page_table(int levels, int PID);
+
+	//Zwalnia ramkę, z której nie korzysta już żaden proces (brudna zawartość wraca do slotu)
+	void release_frame(int frame);
+
+	//Zajmuje slot pliku stronicowania dla danej stronicy (licznik referencji = 1)
+	int alloc_slot(const Page& page);
+
+	//Zmniejsza licznik referencji slotu, nieużywany slot trafia do puli wolnych
+	void release_slot(int slot);
+
+	//Zwraca wskaźnik na zawartość slotu (w pamięci lub w zmapowanym pliku wymiany, bez kompresji)
+	char* slot_data(int slot);
+	const char* slot_data(int slot) const;
+
+	//Zapisuje 16 bajtów stronicy do slotu (w razie potrzeby kompresując je)
+	void store_slot(int slot, const char* data);
+
+	//Odczytuje 16 bajtów stronicy ze slotu (w razie potrzeby rozpakowując je, czas trafia do statystyk)
+	void load_slot(int slot, char* out);
+
+	//Zapisuje zawartość zmodyfikowanej ramki wyrzucanej z pamięci (przy obszarze wymiany na dysku - do bloku dysku)
+	void page_out(int slot, const char* data);
+
+	//Zajmuje miejsce w obszarze wymiany (w razie potrzeby rezerwując kolejny blok dysku), -1 gdy brak miejsca
+	int alloc_disk_slot();
+
+	//Odczytuje zawartość slotu bez liczenia statystyk (np. do wyświetlania)
+	void peek_slot(int slot, char* out) const;
+
+	//Usuwa z puli nieaktualną zawartość i przesuwa pozostałe stronice na początek
+	void compact_pool();
+
+	//Kompresuje stronicę: same-filled -> 0 bajtów, inaczej ciągi literałów i odwołań wstecz (LZ)
+	/* page - 16 bajtów stronicy
+	 * out - bufor na wynik (co najmniej 16 bajtów)
+	 * @return int długość wyniku (16 - stronica zapisana bez kompresji)
+	 */
+	static int compress_page(const char* page, char* out);
+
+	//Rozpakowuje stronicę zapisaną przez compress_page (dla length == 0 wypełnia ją znakiem fill)
+	static void decompress_page(const char* in, int length, char fill, char* page);
+
+	//Czy proces zajmuje już największą dozwoloną ilość ramek
+	bool at_frame_limit(int PID) const;
+
+	//Czy proces musi wymieniać własne stronice (osiągnął limit ramek albo przy wymianie lokalnej ma już gwarantowane ramki)
+	bool replaces_own_frames(int PID) const;
+
+	//Wybiera ramkę ofiarę - najdawniej załadowaną ramkę, której zabranie nie narusza limitów ramek procesów
+	/*  PID - ID procesu, który spowodował błąd stronicy
+	 * @return int numer ramki ofiary
+	 */
+	int select_victim(int PID) const;
+
+	//Dopisuje odwołanie do śladu (jeśli ślad jest zapisywany)
+	void trace_access(int PID, int pageID, bool write);
+
+	//Zapisuje zebrane rekordy śladu do pliku
+	void flush_trace();
 
 	//Zamienia stronice zgodnie z algorytmem  podanym dla pamięci virtualnej
 	/*  *pageList - wskaźnik na indeks stronic procesu
@@ -158,7 +800,12 @@ private:
 
 public:
 	//------------- Konstruktor  -------------
-	MemoryManager();
+	/* frameCount - ilość ramek pamięci fizycznej (rozmiar RAM to frameCount * 16 bajtów)
+	 */
+	explicit MemoryManager(int frameCount = 16);
+	//Ramki pamiętają pozycje na listach zarządcy, więc zarządcy nie można kopiować
+	MemoryManager(const MemoryManager&) = delete;
+	MemoryManager& operator=(const MemoryManager&) = delete;
 	//------------- Destruktor  --------------
 	~MemoryManager();
 };
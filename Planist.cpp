@@ -1,57 +1,192 @@
 #include "Processes.h"
 #include "Planist.h"
+#include "MemoryManager.h"
 #include <list>
 #include <sstream>
 #include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
 
 using namespace std;
 
 Planist planist;
 
-void Planist::check() {
-	//Lista ReadyPCB
-	{
-		for (auto rPCB = ReadyPCB.begin(); rPCB != ReadyPCB.end(); ++rPCB) {
-			if ((*rPCB)->state == TERMINATED) { rPCB = ReadyPCB.erase(rPCB); }
-			else if ((*rPCB)->state != READY && (*rPCB)->state != RUNNING) {
-				WaitingPCB.push_back(*rPCB);
-				rPCB = ReadyPCB.erase(rPCB);
-			}
-		}
-		sort_ready_list();
-	}
-
-	//Lista WaitingPCB
-	{
-		for (auto wPCB = WaitingPCB.begin(); wPCB != WaitingPCB.end(); ++wPCB) {
-			if ((*wPCB)->state == TERMINATED) { wPCB = WaitingPCB.erase(wPCB); }
-			else if ((*wPCB)->state == READY || (*wPCB)->state == RUNNING) {
-				add_process(*wPCB);
-				wPCB = WaitingPCB.erase(wPCB);
-			}
-			if (wPCB == WaitingPCB.end()) { break; }
-		}
-	}
+shared_ptr<PCB> Planist::running_process() const { return current; }
+
+void Planist::check(const shared_ptr<PCB>& executed) {
+	//Polityka uwzględnia wykonany rozkaz (zakończony lub czekający proces nie jest już w kolejce)
+	if (executed != nullptr && policy->contains(executed)) { policy->executed(executed); }
+	select_running();
 }
 
 void Planist::add_process(const shared_ptr<PCB>& process) {
 	//Procesy w stanie READY i RUNNING dodajemy do kolejki
 	if (process->state == READY || process->state == RUNNING) {
-		ReadyPCB.push_back(process);
-		sort_ready_list();
+		//Stan RUNNING dostanie tylko proces ze szczytu kolejki
+		process->state = READY;
+		if (process->PID == 1) { idle = process; }
+		else { policy->push(process); }
+		select_running();
 	}
-	else { WaitingPCB.push_back(process); }
+	else { add_waiting(process); }
+}
+
+void Planist::add_waiting(const shared_ptr<PCB>& process) {
+	process->listPosition = WaitingPCB.insert(WaitingPCB.end(), process);
+}
+
+void Planist::remove_ready(const shared_ptr<PCB>& process) {
+	if (process == idle) { idle = nullptr; }
+	else { policy->remove(process); }
+	select_running();
 }
 
 void Planist::remove_process(const shared_ptr<PCB>& process) {
-	for (auto Rpcb = ReadyPCB.begin(); Rpcb != ReadyPCB.end();) {
-		if ((*Rpcb)->PID == process->PID) { Rpcb = ReadyPCB.erase(Rpcb); }
-		else { ++Rpcb; }
+	if (process == idle || policy->contains(process)) { remove_ready(process); }
+	else if (process->state == SUSPENDED) { SuspendedPCB.remove(process); }
+	else if (process->state != TERMINATED) { WaitingPCB.erase(process->listPosition); }
+}
+
+void Planist::state_changed(const shared_ptr<PCB>& process, Process_state previous) {
+	const bool wasReady = previous == READY || previous == RUNNING;
+	const bool isReady = process->state == READY || process->state == RUNNING;
+
+	//Proces zostaje w tej samej kolejce - wystarczy poprawić, który proces jest wykonywany
+	if (previous == process->state || (wasReady && isReady)) {
+		if (process != current && process->state == RUNNING) { process->state = READY; }
+		select_running();
+		return;
 	}
-	for (auto Wpcb = WaitingPCB.begin(); Wpcb != WaitingPCB.end();) {
-		if ((*Wpcb)->PID == process->PID) { Wpcb = WaitingPCB.erase(Wpcb); }
-		else { ++Wpcb; }
+
+	//Wyjęcie procesu z kolejki odpowiadającej poprzedniemu stanowi
+	if (wasReady) { remove_ready(process); }
+	else if (previous == SUSPENDED) { SuspendedPCB.remove(process); }
+	else if (previous != TERMINATED) { WaitingPCB.erase(process->listPosition); }
+
+	//Zakończony proces nie trafia do żadnej kolejki
+	if (process->state == TERMINATED) { return; }
+	//Proces obudzony po czekaniu - polityka może go inaczej umieścić w kolejce
+	if (previous == WAITING && isReady && process->PID != 1) {
+		process->state = READY;
+		policy->wake(process);
+		select_running();
+	}
+	else { add_process(process); }
+}
+
+void Planist::benchmark(int waiting) {
+	//Pomiar na osobnym planiście - procesy testowe nie trafiają do kolejek ani statystyk planisty systemu
+	static const int TRANSITIONS = 100000;
+	Planist bench;
+
+	//Proces próbny przechodzi między WAITING i READY (tak jak w PCB::change_state, ale w planiście testowym)
+	const auto measure = [&bench]() {
+		const shared_ptr<PCB> probe = make_shared<PCB>("bench_probe", 1);
+		probe->PID = 2;
+		bench.add_process(probe);
+		const auto start = chrono::steady_clock::now();
+		for (int i = 0; i < TRANSITIONS; i++) {
+			probe->state = WAITING;
+			bench.state_changed(probe, READY);
+			probe->state = READY;
+			bench.state_changed(probe, WAITING);
+		}
+		const auto time = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+		bench.remove_process(probe);
+		return static_cast<double>(time) / (2.0 * TRANSITIONS);
+	};
+
+	const double empty = measure();
+	vector<shared_ptr<PCB>> sleepers;
+	sleepers.reserve(waiting);
+	for (int i = 0; i < waiting; i++) {
+		sleepers.push_back(make_shared<PCB>("bench_sleeper", 1));
+		sleepers.back()->PID = 3 + i;
+		sleepers.back()->state = WAITING;
+		bench.add_process(sleepers.back());
 	}
+	const double loaded = measure();
+
+	cout << fixed << setprecision(1);
+	cout << "Przejscie stanu (WAITING <-> READY), " << 2 * TRANSITIONS << " przejsc:\n";
+	cout << " - 0 procesow czekajacych: " << empty << " ns/przejscie\n";
+	cout << " - " << waiting << " procesow czekajacych: " << loaded << " ns/przejscie\n";
+}
+
+void Planist::swapper() {
+	if (!swapperEnabled) { return; }
+
+	//Poza zawieszonymi procesami działa tylko system_dummy - nie ma na co czekać
+	if (!SuspendedPCB.empty() && policy->empty()) {
+		resume();
+		return;
+	}
+
+	//Decyzja zapada dopiero, gdy okno częstości błędów obejmuje rozkazy wykonane po poprzedniej decyzji
+	if (swapperWait > 0) {
+		swapperWait--;
+		return;
+	}
+
+	//Szamotanie - częste błędy stronicy przy zapełnionej pamięci (błędy przy wolnych ramkach to tylko zimny start)
+	const double rate = mm.fault_rate();
+	if (rate > suspendRate && mm.free_frames() == 0 && !policy->empty()) {
+		//Zawieszany jest gotowy proces o najniższym priorytecie według polityki, nigdy wykonywany proces i system_dummy
+		const vector<shared_ptr<PCB>> ready = policy->ordered();
+		if (ready.size() > 1) { suspend(ready.back()); }
+	}
+	//Spadek obciążenia - wolne ramki mieszczą zbiór roboczy zawieszonego procesu albo błędy stronicy prawie ustały
+	else if (!SuspendedPCB.empty() && (rate < resumeRate || mm.free_frames() >= SuspendedPCB.front()->workingSet)) {
+		resume();
+	}
+}
+
+void Planist::suspend(const shared_ptr<PCB>& process) {
+	process->workingSet = mm.swap_out(process->PID);
+	process->state = SUSPENDED;
+	remove_ready(process);
+	SuspendedPCB.push_back(process);
+	suspensions++;
+	swapperWait = SWAPPER_DELAY;
+	cout << "Swapper: zawieszono proces \"" << process->name << "\" (zwolnione ramki: " << process->workingSet << ")\n";
+}
+
+void Planist::resume() {
+	const shared_ptr<PCB> process = SuspendedPCB.front();
+	SuspendedPCB.pop_front();
+	process->state = READY;
+	add_process(process);
+	resumptions++;
+	swapperWait = SWAPPER_DELAY;
+	cout << "Swapper: wznowiono proces \"" << process->name << "\"\n";
+}
+
+void Planist::show_swapper() const {
+	cout << "Swapper: " << (swapperEnabled ? "on" : "off") << fixed << setprecision(3)
+		<< ", zawieszenie > " << suspendRate << ", wznowienie < " << resumeRate << " bledow/rozkaz\n";
+	cout << "Czestosc bledow stronicy: " << mm.fault_rate() << ", wolne ramki: " << mm.free_frames() << '\n';
+	cout << "Zawieszenia: " << suspensions << ", wznowienia: " << resumptions << '\n';
+	cout << "Procesy zawieszone: " << (SuspendedPCB.empty() ? "pusta" : "") << '\n';
+	for (const auto& elem : SuspendedPCB) {
+		cout << " - " << elem->name << ", PID: " << elem->PID << "	(zbior roboczy: " << elem->workingSet << " ramek)\n";
+	}
+}
+
+int Planist::set_swapper(double suspend, double resume) {
+	if (suspend < 0 || resume < 0 || resume > suspend) {
+		cout << "Error: Resume threshold must be between 0 and the suspend threshold!\n";
+		return -1;
+	}
+	suspendRate = suspend;
+	resumeRate = resume;
+	return 1;
+}
+
+void Planist::set_swapper(bool enabled) {
+	swapperEnabled = enabled;
+	//Wyłączony swapper nie przetrzymuje procesów
+	while (!enabled && !SuspendedPCB.empty()) { resume(); }
 }
 
 bool Planist::compare_PCB(const shared_ptr<PCB>& first, const shared_ptr<PCB>& second) {
@@ -64,21 +199,381 @@ bool Planist::compare_PCB(const shared_ptr<PCB>& first, const shared_ptr<PCB>& s
 	return false; //Pierwszy należy zamienić z drugim
 }
 
-void Planist::sort_ready_list() {
-	//Sortowanie listy
-	ReadyPCB.sort(compare_PCB);
+void Planist::select_running() {
+	const shared_ptr<PCB> next = policy->empty() ? idle : policy->top();
+	if (current != nullptr && current != next && current->state == RUNNING) { current->state = READY; }
+	current = next;
+	if (current != nullptr) { current->state = RUNNING; }
+}
+
+void Planist::show_policy() const {
+	cout << "Polityka planisty: ";
+	policy->show();
+}
+
+int Planist::set_policy(const string& name, unsigned int quantum) {
+	unique_ptr<Policy> next;
+	if (name == "sjf") { next = make_unique<ShortestJobFirst>(); }
+	else if (name == "rr") {
+		if (quantum == 0) {
+			cout << "Error: Time quantum must be at least 1 instruction!\n";
+			return -1;
+		}
+		next = make_unique<RoundRobin>(quantum);
+	}
+	else if (name == "cfs") {
+		if (quantum == 0) {
+			cout << "Error: Time quantum must be at least 1 instruction!\n";
+			return -1;
+		}
+		next = make_unique<FairShare>(quantum);
+	}
+	else {
+		cout << "Error: Unknown scheduling policy \"" << name << "\"!\n";
+		return -1;
+	}
+	change_policy(move(next));
+	return 1;
+}
+
+int Planist::set_policy(const vector<unsigned int>& quanta, unsigned int boostPeriod) {
+	if (quanta.empty() || find(quanta.begin(), quanta.end(), 0u) != quanta.end()) {
+		cout << "Error: Every level needs a time quantum of at least 1 instruction!\n";
+		return -1;
+	}
+	change_policy(make_unique<FeedbackQueue>(quanta, boostPeriod));
+	return 1;
+}
+
+int Planist::set_weight(const shared_ptr<PCB>& process, unsigned int weight) {
+	if (weight == 0 || weight > FairShare::VRUNTIME_SCALE) {
+		cout << "Error: Weight must be between 1 and " << FairShare::VRUNTIME_SCALE << "!\n";
+		return -1;
+	}
+	//Waga nie jest kluczem drzewa CFS - zmienia tylko przyrost vruntime kolejnych rozkazów
+	process->weight = weight;
+	return 1;
+}
+
+void Planist::change_policy(unique_ptr<Policy> next) {
+	//Procesy gotowe przechodzą do nowej kolejki w kolejności wyboru dotychczasowej polityki
+	const vector<shared_ptr<PCB>> ready = policy->ordered();
+	for (const auto& process : ready) { policy->remove(process); }
+	policy = move(next);
+	for (const auto& process : ready) { policy->push(process); }
+	select_running();
+}
+
+//------------- SJF -------------
+string Planist::ShortestJobFirst::name() const { return "sjf"; }
+
+void Planist::ShortestJobFirst::show() const { cout << "sjf (najkrotszy czas do konca, z wywlaszczaniem)\n"; }
 
-	//Ustawienie pierwszego procesu na RUNNING a reszty na READY
-	for (auto it = ReadyPCB.begin(); it != ReadyPCB.end(); ++it) {
-		if (it == ReadyPCB.begin()) { (*it)->state = RUNNING; }
-		else if ((*it)->state != READY) { (*it)->state = READY; }
+void Planist::ShortestJobFirst::push(const shared_ptr<PCB>& process) { queue.push(process); }
+
+void Planist::ShortestJobFirst::remove(const shared_ptr<PCB>& process) { queue.remove(process); }
+
+bool Planist::ShortestJobFirst::contains(const shared_ptr<PCB>& process) const { return queue.contains(process); }
+
+//Wykonany proces ma mniejszy czas do końca
+void Planist::ShortestJobFirst::executed(const shared_ptr<PCB>& process) { queue.update(process); }
+
+shared_ptr<PCB> Planist::ShortestJobFirst::top() const { return queue.top(); }
+
+size_t Planist::ShortestJobFirst::size() const { return queue.size(); }
+
+//Kopiec jest sortowany tylko na potrzeby wyświetlenia i wyboru ofiary swappera
+vector<shared_ptr<PCB>> Planist::ShortestJobFirst::ordered() const {
+	vector<shared_ptr<PCB>> ready = queue.items();
+	sort(ready.begin(), ready.end(), compare_PCB);
+	return ready;
+}
+
+//------------- RR -------------
+Planist::RoundRobin::RoundRobin(unsigned int quantum) : quantum(quantum) {}
+
+string Planist::RoundRobin::name() const { return "rr"; }
+
+void Planist::RoundRobin::show() const {
+	cout << "rr (kwant: " << quantum << " rozkazow)\n";
+	if (!queue.empty()) {
+		cout << "Proces \"" << queue.front()->name << "\" wykorzystal " << used << " z " << quantum << " rozkazow kwantu\n";
 	}
 }
 
+void Planist::RoundRobin::push(const shared_ptr<PCB>& process) {
+	if (contains(process)) { return; }
+	process->readyPosition = 0;
+	process->listPosition = queue.insert(queue.end(), process);
+}
+
+void Planist::RoundRobin::remove(const shared_ptr<PCB>& process) {
+	if (!contains(process)) { return; }
+	//Następny proces zaczyna nowy kwant
+	if (process == queue.front()) { used = 0; }
+	queue.erase(process->listPosition);
+	process->readyPosition = -1;
+}
+
+bool Planist::RoundRobin::contains(const shared_ptr<PCB>& process) const { return process->readyPosition == 0; }
+
+void Planist::RoundRobin::executed(const shared_ptr<PCB>& process) {
+	if (process != queue.front()) { return; }
+	used++;
+	//Wykorzystany kwant - wywłaszczenie na koniec kolejki
+	if (used >= quantum) {
+		queue.splice(queue.end(), queue, queue.begin());
+		used = 0;
+	}
+}
+
+shared_ptr<PCB> Planist::RoundRobin::top() const { return queue.front(); }
+
+size_t Planist::RoundRobin::size() const { return queue.size(); }
+
+vector<shared_ptr<PCB>> Planist::RoundRobin::ordered() const { return vector<shared_ptr<PCB>>(queue.begin(), queue.end()); }
+
+//------------- MLFQ -------------
+Planist::FeedbackQueue::FeedbackQueue(const vector<unsigned int>& quanta, unsigned int boostPeriod)
+	: levels(quanta.size()), quanta(quanta), boostPeriod(boostPeriod) {}
+
+string Planist::FeedbackQueue::name() const { return "mlfq"; }
+
+void Planist::FeedbackQueue::show() const {
+	cout << "mlfq (poziomy: " << levels.size() << ", podniesienie priorytetow ";
+	if (boostPeriod == 0) { cout << "wylaczone)\n"; }
+	else { cout << "co " << boostPeriod << " rozkazow, nastepne za " << boostPeriod - sinceBoost << ")\n"; }
+	for (size_t i = 0; i < levels.size(); i++) {
+		cout << " - poziom " << i << " (kwant: " << quanta[i] << "):";
+		for (const auto& process : levels[i]) { cout << ' ' << process->name << " [" << process->quantumUsed << '/' << quanta[i] << ']'; }
+		cout << '\n';
+	}
+	cout << "Obnizenia: " << demotions << ", podwyzszenia: " << promotions << ", podniesienia wszystkich: " << boosts << '\n';
+}
+
+void Planist::FeedbackQueue::push(const shared_ptr<PCB>& process) {
+	if (contains(process)) { return; }
+	//Poziom zapamiętany w PCB może pochodzić z polityki o większej ilości poziomów
+	process->level = min(process->level, static_cast<int>(levels.size()) - 1);
+	process->readyPosition = process->level;
+	process->listPosition = levels[process->level].insert(levels[process->level].end(), process);
+	count++;
+}
+
+void Planist::FeedbackQueue::wake(const shared_ptr<PCB>& process) {
+	//Proces oddał procesor przed końcem kwantu, bo czekał - jest interaktywny
+	if (process->level > 0) {
+		process->level--;
+		promotions++;
+	}
+	process->quantumUsed = 0;
+	push(process);
+}
+
+void Planist::FeedbackQueue::remove(const shared_ptr<PCB>& process) {
+	if (!contains(process)) { return; }
+	levels[process->readyPosition].erase(process->listPosition);
+	process->readyPosition = -1;
+	count--;
+}
+
+bool Planist::FeedbackQueue::contains(const shared_ptr<PCB>& process) const {
+	return process->readyPosition >= 0 && static_cast<size_t>(process->readyPosition) < levels.size() && process->readyPosition == process->level;
+}
+
+void Planist::FeedbackQueue::executed(const shared_ptr<PCB>& process) {
+	process->quantumUsed++;
+	//Wykorzystany kwant - proces trafia na koniec kolejki niższego poziomu (albo tego samego na najniższym)
+	if (process->quantumUsed >= quanta[process->level]) {
+		remove(process);
+		if (process->level + 1 < static_cast<int>(levels.size())) {
+			process->level++;
+			demotions++;
+		}
+		process->quantumUsed = 0;
+		push(process);
+	}
+
+	if (boostPeriod != 0 && ++sinceBoost >= boostPeriod) { boost(); }
+}
+
+void Planist::FeedbackQueue::boost() {
+	//Procesy z niższych poziomów trafiają na koniec najwyższego w kolejności dotychczasowego priorytetu
+	for (size_t i = 1; i < levels.size(); i++) {
+		for (const auto& process : levels[i]) {
+			process->level = 0;
+			process->readyPosition = 0;
+		}
+		levels[0].splice(levels[0].end(), levels[i]);
+	}
+	for (const auto& process : levels[0]) { process->quantumUsed = 0; }
+	sinceBoost = 0;
+	boosts++;
+}
+
+shared_ptr<PCB> Planist::FeedbackQueue::top() const {
+	for (const auto& level : levels) {
+		if (!level.empty()) { return level.front(); }
+	}
+	return nullptr;
+}
+
+size_t Planist::FeedbackQueue::size() const { return count; }
+
+vector<shared_ptr<PCB>> Planist::FeedbackQueue::ordered() const {
+	vector<shared_ptr<PCB>> ready;
+	ready.reserve(count);
+	for (const auto& level : levels) { ready.insert(ready.end(), level.begin(), level.end()); }
+	return ready;
+}
+
+//------------- CFS -------------
+bool Planist::FairShare::ByVruntime::operator()(const shared_ptr<PCB>& first, const shared_ptr<PCB>& second) const {
+	return first->vruntime < second->vruntime || (first->vruntime == second->vruntime && first->PID < second->PID);
+}
+
+Planist::FairShare::FairShare(unsigned int quantum) : quantum(quantum) {}
+
+string Planist::FairShare::name() const { return "cfs"; }
+
+void Planist::FairShare::show() const {
+	cout << "cfs (kwant: " << quantum << " rozkazow, najmniejszy vruntime: " << minVruntime << ")\n";
+	for (const auto& process : ordered()) {
+		cout << " - " << process->name << ", PID: " << process->PID << "\t(waga: " << process->weight << ", vruntime: " << process->vruntime;
+		if (process == chosen) { cout << ", wykorzystal " << used << " z " << quantum << " rozkazow kwantu"; }
+		cout << ")\n";
+	}
+}
+
+void Planist::FairShare::push(const shared_ptr<PCB>& process) {
+	if (contains(process)) { return; }
+	process->vruntime = max(process->vruntime, minVruntime);
+	queue.insert(process);
+}
+
+void Planist::FairShare::remove(const shared_ptr<PCB>& process) {
+	if (!contains(process)) { return; }
+	//Następny proces zaczyna nowy kwant
+	if (process == chosen) {
+		chosen = nullptr;
+		used = 0;
+	}
+	queue.erase(process);
+}
+
+bool Planist::FairShare::contains(const shared_ptr<PCB>& process) const {
+	const auto found = queue.find(process);
+	return found != queue.end() && *found == process;
+}
+
+void Planist::FairShare::executed(const shared_ptr<PCB>& process) {
+	//Zmiana klucza - proces jest ponownie wstawiany do drzewa
+	queue.erase(process);
+	process->vruntime += VRUNTIME_SCALE / process->weight;
+	queue.insert(process);
+
+	if (process != chosen) {
+		chosen = process;
+		used = 0;
+	}
+	//Koniec kwantu - następny wykonywany jest proces z najmniejszym vruntime
+	if (++used >= quantum) {
+		chosen = nullptr;
+		used = 0;
+	}
+	minVruntime = max(minVruntime, (*queue.begin())->vruntime);
+}
+
+shared_ptr<PCB> Planist::FairShare::top() const { return chosen != nullptr ? chosen : *queue.begin(); }
+
+size_t Planist::FairShare::size() const { return queue.size(); }
+
+//Proces wykonywany w bieżącym kwancie jest pierwszy, pozostałe według vruntime
+vector<shared_ptr<PCB>> Planist::FairShare::ordered() const {
+	vector<shared_ptr<PCB>> ready;
+	ready.reserve(queue.size());
+	if (chosen != nullptr) { ready.push_back(chosen); }
+	for (const auto& process : queue) {
+		if (process != chosen) { ready.push_back(process); }
+	}
+	return ready;
+}
+
+//------------- Kopiec procesów gotowych -------------
+void Planist::ReadyQueue::place(size_t position, const shared_ptr<PCB>& process) {
+	heap[position] = process;
+	process->readyPosition = static_cast<int>(position);
+}
+
+void Planist::ReadyQueue::sift_up(size_t position) {
+	const shared_ptr<PCB> process = heap[position];
+	while (position > 0) {
+		const size_t parent = (position - 1) / 2;
+		if (!compare_PCB(process, heap[parent])) { break; }
+		place(position, heap[parent]);
+		position = parent;
+	}
+	place(position, process);
+}
+
+void Planist::ReadyQueue::sift_down(size_t position) {
+	const shared_ptr<PCB> process = heap[position];
+	while (true) {
+		size_t child = 2 * position + 1;
+		if (child >= heap.size()) { break; }
+		if (child + 1 < heap.size() && compare_PCB(heap[child + 1], heap[child])) { child++; }
+		if (!compare_PCB(heap[child], process)) { break; }
+		place(position, heap[child]);
+		position = child;
+	}
+	place(position, process);
+}
+
+void Planist::ReadyQueue::push(const shared_ptr<PCB>& process) {
+	if (contains(process)) { return; }
+	heap.push_back(process);
+	process->readyPosition = static_cast<int>(heap.size() - 1);
+	sift_up(heap.size() - 1);
+}
+
+void Planist::ReadyQueue::remove(const shared_ptr<PCB>& process) {
+	if (!contains(process)) { return; }
+	const size_t position = process->readyPosition;
+	process->readyPosition = -1;
+
+	//Na miejsce usuwanego procesu trafia ostatni element kopca
+	const shared_ptr<PCB> last = heap.back();
+	heap.pop_back();
+	if (position == heap.size()) { return; }
+	place(position, last);
+	sift_up(position);
+	sift_down(last->readyPosition);
+}
+
+void Planist::ReadyQueue::update(const shared_ptr<PCB>& process) {
+	if (!contains(process)) { return; }
+	sift_up(process->readyPosition);
+	sift_down(process->readyPosition);
+}
+
+bool Planist::ReadyQueue::contains(const shared_ptr<PCB>& process) const {
+	return process->readyPosition >= 0 && static_cast<size_t>(process->readyPosition) < heap.size() && heap[process->readyPosition] == process;
+}
+
+const shared_ptr<PCB>& Planist::ReadyQueue::top() const { return heap.front(); }
+
+bool Planist::ReadyQueue::empty() const { return heap.empty(); }
+
+size_t Planist::ReadyQueue::size() const { return heap.size(); }
+
+const vector<shared_ptr<PCB>>& Planist::ReadyQueue::items() const { return heap; }
+
 void Planist::display_PCB_lists() {
-	//Wyświetlanie ReadyPCB
-	cout << "Procesy gotowe: " << (ReadyPCB.empty() ? "pusta" : "") << "\n";
-	for (const auto& elem : ReadyPCB) {
+	//Wyświetlanie procesów gotowych w kolejności wyboru przez politykę (system_dummy na końcu)
+	vector<shared_ptr<PCB>> ready = policy->ordered();
+	if (idle != nullptr) { ready.push_back(idle); }
+	cout << "Procesy gotowe: " << (ready.empty() ? "pusta" : "") << "\n";
+	for (const auto& elem : ready) {
 		cout << " - " << elem->name << ", PID: " << elem->PID;
 		if (elem->executionTimeLeft != 9999) {
 			cout << "	(cykle: " << elem->executionTimeLeft;
@@ -102,5 +597,12 @@ void Planist::display_PCB_lists() {
 		else if (elem->state == WAITING) { cout << " (WAITING)"; }
 		cout << '\n';
 	}
+
+	//Wyświetlanie SuspendedPCB
+	cout << "\nProcesy zawieszone: " << (SuspendedPCB.empty() ? "pusta" : "") << "\n";
+	for (const auto& elem : SuspendedPCB) {
+		cout << " - " << elem->name << ", PID: " << elem->PID;
+		cout << "	(cykle: " << elem->executionTimeLeft << ", ramki: " << elem->workingSet << ")\n";
+	}
 	cout << '\n';
 }
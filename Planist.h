@@ -1,29 +1,245 @@
 #pragma once
 
+#include "Processes.h"
+#include <string>
 #include <list>
+#include <vector>
+#include <set>
 #include <memory>
 
-class PCB;
-
 //Zakamy, e jeden rozkaz wymaga jednego cyklu procesora
 
 class Planist {
 private:
 	std::list<std::shared_ptr<PCB>> WaitingPCB;
+	std::list<std::shared_ptr<PCB>> SuspendedPCB; //Procesy zawieszone przez swapper (w kolejnoci zawieszenia)
+
+	//Swapper (planista rednioterminowy) - przy szamotaniu zawiesza procesy o najniszym priorytecie
+	static const int SWAPPER_DELAY = 32; //Ilo rozkazw midzy decyzjami swappera (tyle obejmuje okno czstoci bdw stronicy)
+	bool swapperEnabled = true;
+	double suspendRate = 0.5; //Czsto bdw stronicy (bdy na rozkaz), powyej ktrej proces zostaje zawieszony
+	double resumeRate = 0.1; //Czsto bdw stronicy, poniej ktrej zawieszony proces moe zosta wznowiony
+	int swapperWait = 0; //Ilo rozkazw do nastpnej decyzji swappera
+	unsigned long long suspensions = 0;
+	unsigned long long resumptions = 0;
+
+	void suspend(const std::shared_ptr<PCB>& process);
+	void resume();
+
+	//Dopisuje proces na koniec listy procesw czekajcych (pozycja zapamitana w PCB)
+	void add_waiting(const std::shared_ptr<PCB>& process);
 
 	static bool compare_PCB(const std::shared_ptr<PCB>& first, const std::shared_ptr<PCB>& second);
-	void sort_ready_list();
 
-public:
-	std::list<std::shared_ptr<PCB>> ReadyPCB;
+	//Polityka planowania - kolejka procesw gotowych (bez system_dummy) i wybr procesu do wykonania
+	class Policy {
+	public:
+		virtual ~Policy() = default;
+
+		virtual std::string name() const = 0;
+		virtual void show() const = 0; //Ustawienia i stan polityki
+
+		virtual void push(const std::shared_ptr<PCB>& process) = 0;
+		//Proces wraca do kolejki po czekaniu (WAITING) - domylnie jak kady nowy proces gotowy
+		virtual void wake(const std::shared_ptr<PCB>& process) { push(process); }
+		virtual void remove(const std::shared_ptr<PCB>& process) = 0;
+		virtual bool contains(const std::shared_ptr<PCB>& process) const = 0;
+		//Proces wykona rozkaz (wywoywane tylko dla procesw z kolejki)
+		virtual void executed(const std::shared_ptr<PCB>& process) = 0;
+
+		//Proces, ktry powinien wykona nastpny rozkaz (kolejka nie moe by pusta)
+		virtual std::shared_ptr<PCB> top() const = 0;
+		virtual size_t size() const = 0;
+		bool empty() const { return size() == 0; }
+		//Procesy w kolejnoci wyboru - ostatni ma najniszy priorytet
+		virtual std::vector<std::shared_ptr<PCB>> ordered() const = 0;
+	};
+
+	//Kolejka procesw gotowych - kopiec binarny uporzdkowany wedug (executionTimeLeft, PID)
+	//Pozycja procesu w kopcu zapisana jest w PCB, wic dodanie, usunicie i zmiana klucza kosztuj O(log n)
+	class ReadyQueue {
+	private:
+		std::vector<std::shared_ptr<PCB>> heap;
+
+		void place(size_t position, const std::shared_ptr<PCB>& process);
+		void sift_up(size_t position);
+		void sift_down(size_t position);
+
+	public:
+		void push(const std::shared_ptr<PCB>& process);
+		void remove(const std::shared_ptr<PCB>& process);
+		//Przywraca porzdek kopca po zmianie czasu wykonania procesu (zmniejszenie lub zwikszenie klucza)
+		void update(const std::shared_ptr<PCB>& process);
+		bool contains(const std::shared_ptr<PCB>& process) const;
+
+		const std::shared_ptr<PCB>& top() const;
+		bool empty() const;
+		size_t size() const;
+		//Procesy w kolejnoci kopca (nie posortowane)
+		const std::vector<std::shared_ptr<PCB>>& items() const;
+	};
+
+	//SJF - wykonywany jest proces z najkrtszym czasem do koca, sprawdzane po kadym rozkazie (proces z krtszym czasem wywaszcza)
+	class ShortestJobFirst : public Policy {
+	private:
+		ReadyQueue queue;
+
+	public:
+		std::string name() const override;
+		void show() const override;
+		void push(const std::shared_ptr<PCB>& process) override;
+		void remove(const std::shared_ptr<PCB>& process) override;
+		bool contains(const std::shared_ptr<PCB>& process) const override;
+		void executed(const std::shared_ptr<PCB>& process) override;
+		std::shared_ptr<PCB> top() const override;
+		size_t size() const override;
+		std::vector<std::shared_ptr<PCB>> ordered() const override;
+	};
+
+	//RR - procesy wykonywane po kolei, po wykorzystaniu kwantu proces wywaszczany jest na koniec kolejki
+	//Proces wracajcy do kolejki (nowy, obudzony lub wznowiony) trafia na jej koniec z penym kwantem
+	class RoundRobin : public Policy {
+	private:
+		std::list<std::shared_ptr<PCB>> queue; //Pocztek kolejki jest procesem wykonywanym
+		unsigned int quantum; //Ilo rozkazw, po ktrej proces jest wywaszczany
+		unsigned int used = 0; //Ilo rozkazw wykonanych przez pocztek kolejki w biecym kwancie
+
+	public:
+		explicit RoundRobin(unsigned int quantum);
+
+		std::string name() const override;
+		void show() const override;
+		void push(const std::shared_ptr<PCB>& process) override;
+		void remove(const std::shared_ptr<PCB>& process) override;
+		bool contains(const std::shared_ptr<PCB>& process) const override;
+		void executed(const std::shared_ptr<PCB>& process) override;
+		std::shared_ptr<PCB> top() const override;
+		size_t size() const override;
+		std::vector<std::shared_ptr<PCB>> ordered() const override;
+	};
 
+	//MLFQ - kolejki o malejcym priorytecie, w kadej procesy wykonywane po kolei z kwantem danego poziomu
+	//Wykorzystanie kwantu obnia poziom procesu, powrt z czekania (semafor, potok, plik) podnosi go o jeden
+	//Co okres podniesienia wszystkie procesy gotowe wracaj na najwyszy poziom (procesy na niskich poziomach nie s godzone)
+	class FeedbackQueue : public Policy {
+	private:
+		std::vector<std::list<std::shared_ptr<PCB>>> levels; //Poziom 0 ma najwyszy priorytet
+		std::vector<unsigned int> quanta; //Kwant czasu kadego poziomu (w rozkazach)
+		unsigned int boostPeriod; //Ilo rozkazw midzy podniesieniami priorytetw, 0 - bez podniesie
+		unsigned int sinceBoost = 0;
+		size_t count = 0;
+
+		unsigned long long demotions = 0;
+		unsigned long long promotions = 0;
+		unsigned long long boosts = 0;
+
+		void boost();
+
+	public:
+		FeedbackQueue(const std::vector<unsigned int>& quanta, unsigned int boostPeriod);
+
+		std::string name() const override;
+		void show() const override;
+		void push(const std::shared_ptr<PCB>& process) override;
+		void wake(const std::shared_ptr<PCB>& process) override;
+		void remove(const std::shared_ptr<PCB>& process) override;
+		bool contains(const std::shared_ptr<PCB>& process) const override;
+		void executed(const std::shared_ptr<PCB>& process) override;
+		std::shared_ptr<PCB> top() const override;
+		size_t size() const override;
+		std::vector<std::shared_ptr<PCB>> ordered() const override;
+	};
+
+	//CFS - procesy gotowe w drzewie uporzdkowanym wedug (vruntime, PID), co kwant wykonywany jest proces z najmniejszym vruntime
+	//vruntime ronie odwrotnie proporcjonalnie do wagi, wic procesy dostaj procesor proporcjonalnie do wag
+	//Proces dodany lub obudzony dostaje co najmniej najmniejszy vruntime kolejki (dugie czekanie nie daje mu dugiego pierwszestwa)
+	class FairShare : public Policy {
+	private:
+		struct ByVruntime {
+			bool operator()(const std::shared_ptr<PCB>& first, const std::shared_ptr<PCB>& second) const;
+		};
+		std::set<std::shared_ptr<PCB>, ByVruntime> queue;
+		unsigned int quantum; //Ilo rozkazw wykonywanych przed ponownym wyborem najmniejszego vruntime
+		std::shared_ptr<PCB> chosen = nullptr; //Proces wykonywany w biecym kwancie (nullptr - wybr z pocztku drzewa)
+		unsigned int used = 0;
+		unsigned long long minVruntime = 0; //Najmniejszy vruntime kolejki, nigdy nie maleje
+
+	public:
+		static constexpr unsigned long long VRUNTIME_SCALE = 1024ull * 1024; //Przyrost vruntime za rozkaz to VRUNTIME_SCALE / waga
+
+		explicit FairShare(unsigned int quantum);
+
+		std::string name() const override;
+		void show() const override;
+		void push(const std::shared_ptr<PCB>& process) override;
+		void remove(const std::shared_ptr<PCB>& process) override;
+		bool contains(const std::shared_ptr<PCB>& process) const override;
+		void executed(const std::shared_ptr<PCB>& process) override;
+		std::shared_ptr<PCB> top() const override;
+		size_t size() const override;
+		std::vector<std::shared_ptr<PCB>> ordered() const override;
+	};
+
+	std::unique_ptr<Policy> policy = std::make_unique<ShortestJobFirst>();
+	//Przenosi procesy gotowe do nowej polityki w kolejnoci wyboru dotychczasowej
+	void change_policy(std::unique_ptr<Policy> next);
+	//system_dummy nie naley do kolejki polityki - wykonywany jest tylko, gdy kolejka gotowych jest pusta
+	std::shared_ptr<PCB> idle = nullptr;
+	//Usuwa proces gotowy z kolejki polityki (albo system_dummy)
+	void remove_ready(const std::shared_ptr<PCB>& process);
+
+	//Proces wykonywany (RUNNING) - wybrany przez polityk, pozostae procesy w kolejce s READY
+	std::shared_ptr<PCB> current = nullptr;
+	//Ustawia proces wybrany przez polityk jako wykonywany (poprzedni wraca do stanu READY)
+	void select_running();
+
+public:
 	Planist() = default;
 	~Planist() = default;
 
-	void check();
+	//Proces, ktry wykona nastpny rozkaz (nullptr, gdy kolejka gotowych jest pusta)
+	std::shared_ptr<PCB> running_process() const;
+
+	//Aktualizacja po wykonaniu rozkazu (czas do koca procesu, kwant czasu) i wybr nastpnego procesu
+	/* executed - proces, ktry wykona rozkaz (mg ju zakoczy dziaanie albo zacz czeka)
+	 */
+	void check(const std::shared_ptr<PCB>& executed);
 	void add_process(const std::shared_ptr<PCB>& process);
 	void remove_process(const std::shared_ptr<PCB>& process);
 
+	//Przejcie procesu midzy stanami (wywoywane przez PCB::change_state)
+	//Przenosi tylko ten jeden proces midzy kolejkami - O(log n) zamiast przegldania wszystkich list
+	/* process - proces, ktry zmieni stan (nowy stan jest ju w PCB)
+	 * previous - stan przed zmian (okrela kolejk, w ktrej proces si znajduje)
+	 */
+	void state_changed(const std::shared_ptr<PCB>& process, Process_state previous);
+
+	//Mierzy redni czas przejcia stanu (WAITING <-> READY) bez procesw czekajcych i z podan ich iloci
+	//Pomiar odbywa si na osobnym planicie, wic nie zmienia kolejek ani stanu procesw systemu
+	static void benchmark(int waiting);
+
+	//Polityka planowania
+	void show_policy() const;
+	//Zmienia polityk planowania, procesy gotowe przechodz do nowej kolejki w kolejnoci dotychczasowej polityki
+	/* name - "sjf", "rr" albo "cfs"
+	 * quantum - kwant czasu w rozkazach (RR, CFS)
+	 */
+	int set_policy(const std::string& name, unsigned int quantum);
+	//Zmienia polityk planowania na MLFQ
+	/* quanta - kwanty czasu kolejnych poziomw (ilo poziomw), od najwyszego priorytetu
+	 * boostPeriod - ilo rozkazw midzy podniesieniami priorytetw wszystkich procesw gotowych, 0 - bez podniesie
+	 */
+	int set_policy(const std::vector<unsigned int>& quanta, unsigned int boostPeriod);
+	//Zmienia wag procesu w CFS (udzia w czasie procesora proporcjonalny do wagi, 1024 - domylna)
+	int set_weight(const std::shared_ptr<PCB>& process, unsigned int weight);
+
+	//Swapper - wywoywany po kadym rozkazie, zawiesza lub wznawia procesy zalenie od czstoci bdw stronicy
+	void swapper();
+	void show_swapper() const;
+	//Zmienia progi swappera (suspend - prg zawieszenia, resume - prg wznowienia, bdy stronicy na rozkaz)
+	int set_swapper(double suspend, double resume);
+	void set_swapper(bool enabled);
+
 	//Praca krokowa
 	void display_PCB_lists();
 };
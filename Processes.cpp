@@ -6,7 +6,6 @@
 #include "FileManager.h"
 #include <iostream>
 #include <memory>
-#include <fstream>
 
 using namespace std;
 
@@ -14,7 +13,11 @@ ProcTree tree;
 
 //PCB ----------------
 
-void PCB::change_state(const Process_state& x) { this->state = x; planist.check(); }
+void PCB::change_state(const Process_state& x) {
+	const Process_state previous = this->state;
+	this->state = x;
+	planist.state_changed(shared_from_this(), previous);
+}
 
 void PCB::kill() {
 	if (!this->childVector.empty()) {
@@ -23,6 +26,7 @@ void PCB::kill() {
 		}
 	}
 	fm.file_close_all(this->name);
+	mm.shm_detach_all(this->PID);
 	mm.kill(this->PID);
 	pipeline.remove(this->name);
 	this->childVector.clear(); //Tu następuje usunięcie wszystkich dzieci
@@ -108,6 +112,7 @@ void PCB::display() {
 	case WAITING: cout << "WAITING"; break;
 	case READY: cout << "READY"; break;
 	case TERMINATED: cout << "TERMINATED"; break;
+	case SUSPENDED: cout << "SUSPENDED"; break;
 	default:;
 	}
 	cout << '\n';
@@ -117,7 +122,7 @@ void PCB::display() {
 	cout << " | D : " << registers[3] << '\n';
 }
 
-void PCB::resize(const unsigned& size) { mm.resize_page_list(size, this); }
+int PCB::resize(const unsigned& size) { return mm.resize_page_list(size, this); }
 
 //ProcTree ----------------
 
@@ -160,6 +165,30 @@ void ProcTree::fork(const string& procName, const unsigned int& parentPID, const
 	}
 }
 
+void ProcTree::fork(const string& procName, const unsigned int& parentPID) {
+	const shared_ptr<PCB> parent = (parentPID == this->dummyProc->PID) ? this->dummyProc : this->dummyProc->get_kid(parentPID);
+	if (parent == nullptr) {
+		cout << "Nie znaleziono rodzica!\n";
+		return;
+	}
+
+	const shared_ptr<PCB> kid = make_shared<PCB>(procName, parentPID);
+	kid->parent = parent;
+	kid->PID = freePID;
+	parent->childVector.push_back(kid);
+	freePID++;
+
+	//Dziecko kontynuuje wykonanie od miejsca, w którym rodzic wykonał fork
+	kid->pageTable = mm.fork_page_list(parent, kid->PID);
+	kid->size = parent->size;
+	kid->registers = parent->registers;
+	kid->instructionCounter = parent->instructionCounter;
+	kid->executionTimeLeft = parent->executionTimeLeft;
+	kid->weight = parent->weight;
+
+	planist.add_process(kid);
+}
+
 void ProcTree::kill(const std::string& procName) const {
 	if (procName == this->dummyProc->name) { // kiedy damy id=1 
 		cout << "Nie mozna usunac system_dummy!\n";
@@ -186,7 +215,7 @@ void ProcTree::init() {
 	this->dummyProc = make_shared<PCB>();
 	planist.add_process(dummyProc);
 	mm.memory_init();
-	dummyProc->pageList = mm.create_page_list(16, 1);
+	dummyProc->pageTable = mm.create_page_list(16, 1);
 }
 
 void ProcTree::display() const
@@ -214,8 +243,13 @@ void ProcTree::add_kid(const std::shared_ptr<PCB>& parent, const std::shared_ptr
 	parent->childVector.push_back(kid);
 	freePID++;
 	const auto pageNum = static_cast<unsigned int>(ceil(size / 16.0));
-	kid->pageList = mm.create_page_list(size, kid->PID);
+	kid->pageTable = mm.create_page_list(size, kid->PID);
+	if (kid->pageTable == -1) {
+		kill(kid->name);
+		return;
+	}
 	kid->size = pageNum * 16;
+	kid->weight = parent->weight;
 
 	kid->executionTimeLeft = 5;
 
@@ -228,7 +262,8 @@ void ProcTree::add_kid(const std::shared_ptr<PCB>& parent, const std::shared_ptr
 	parent->childVector.push_back(kid);
 	freePID++;
 
-	const int size = mm.load_program(fileName, kid->PID);
+	string programWhole;
+	const int size = mm.load_program(fileName, kid->PID, programWhole);
 	const auto pageNum = static_cast<unsigned int>(ceil(size / 16.0));
 
 	if (size == -1) {
@@ -237,20 +272,15 @@ void ProcTree::add_kid(const std::shared_ptr<PCB>& parent, const std::shared_ptr
 	}
 
 
-	kid->pageList = mm.create_page_list(size, kid->PID);
-	kid->size = pageNum * 16;
-
-	//Tymczasowe ściągnięcie programu
-	string programWhole;
-	ifstream programFile(fileName);
-	char c;
-	while (programFile >> noskipws >> c) {
-		if (c == '\n' || c == '\r') { programWhole += ';'; }
-		else { programWhole += c; }
+	kid->pageTable = mm.create_page_list(size, kid->PID);
+	if (kid->pageTable == -1) {
+		kill(kid->name);
+		return;
 	}
-	if (*(programWhole.end() - 1) != ';') { programWhole += ';'; }
-	programFile.close();
+	kid->size = pageNum * 16;
+	kid->weight = parent->weight;
 
+	//Czas wykonania szacowany jest na programie wczytanym przez MemoryManagera (bez ponownego czytania pliku)
 	kid->executionTimeLeft = interpreter.simulate_program(programWhole);
 
 	planist.add_process(kid);
@@ -3,30 +3,37 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <list>
 #include <memory>
 
-struct PageTableData;
 class MemoryManager;
 class Planist;
 class Pipeline;
 
 enum Process_state {
-	READY, RUNNING, WAITING, TERMINATED
-}; //stany procesu
+	READY, RUNNING, WAITING, TERMINATED, SUSPENDED
+}; //stany procesu (SUSPENDED - proces zawieszony przez swapper, bez ramek w pamięci RAM)
 
-class PCB {
+class PCB : public std::enable_shared_from_this<PCB> {
 public:
 	std::string name;		//nazwa procesu
 	unsigned int PID;		//identyfikator, 1 jest "dla system_dummy"
 	Process_state state;	//stan procesu (planista)
 
 	unsigned int executionTimeLeft = 0; //ilość cykli potrzebna do zakończenia programu (planista)
+	int workingSet = 0; //ilość ramek zajmowanych przez proces w chwili zawieszenia (swapper)
+	int readyPosition = -1; //pozycja w kopcu procesów gotowych (SJF) albo numer kolejki (RR, MLFQ), -1 gdy procesu nie ma w kolejce gotowych (planista)
+	std::list<std::shared_ptr<PCB>>::iterator listPosition; //pozycja na liście procesów czekających albo w kolejce gotowych RR, MLFQ (planista)
+	int level = 0; //poziom kolejki MLFQ, zachowywany na czas czekania (planista)
+	unsigned int quantumUsed = 0; //ilość rozkazów wykonanych w kwancie bieżącego poziomu MLFQ (planista)
+	unsigned int weight = 1024; //waga procesu w CFS, 1024 - domyślna, dziedziczona przez dzieci (planista)
+	unsigned long long vruntime = 0; //czas wirtualny w CFS - rozkazy ważone odwrotnością wagi, 1024 na rozkaz przy domyślnej wadze (planista)
 
 	std::shared_ptr<PCB> parent = nullptr;		//wskaźnik na rodzica procesu
 	std::vector<std::shared_ptr<PCB>> childVector;	//wektor dzieci procesu
 	
-	//wskaźnik wektora stronic (zarządzanie pamięcią)
-	std::shared_ptr<std::vector<PageTableData>>pageList = nullptr;
+	//indeks tablicy stronic w puli tablic MemoryManagera (zarządzanie pamięcią)
+	int pageTable = -1;
 
 	//Deskryptor (pipe)
 	std::array<int, 2>  FD;
@@ -57,13 +64,13 @@ public:
 	std::shared_ptr<PCB> get_kid(const std::string& nazwa); //funckja pomocnicza do znalezienia procesu po nazwie
 	bool find_kid(const unsigned int& PID) const;
 
-	void change_state(const Process_state& x); //zmiana stanu procesu (korzysta z planisty)
+	void change_state(const Process_state& x); //zmiana stanu procesu (planista przenosi proces do odpowiedniej kolejki)
 
 	//Zabija proces wraz z wszystkimi dziećmi
 	void kill();
 
 	//Zmienia rozmiar pamięci zaalokowanej dla procesu
-	void resize(const unsigned int& size);
+	int resize(const unsigned int& size);
 
 	void display_kid_all(); //funkcja która pokazuje całe potomstwo procesu
 	void display_kid(int a); //funkcja pomocnicza do tej wyżej
@@ -86,6 +93,9 @@ public:
 	//fork tworzący proces z programem z pliku
 	void fork(const std::string& procName, const unsigned int& parentPID, const std::string& fileName);
 
+	//fork tworzący kopię procesu rodzica (pamięć współdzielona copy-on-write albo kopiowana, zależnie od trybu MemoryManagera)
+	void fork(const std::string& procName, const unsigned int& parentPID);
+
 	//usuwanie procesów 
 	void kill(const std::string& procName) const;
 
@@ -24,8 +24,8 @@ public:
 	void show_value() const;
 
 private:
-	void block(const std::shared_ptr<PCB>& pcb); //Zmienia stan procesu na WAITING i wywołuje funkcję check() od planisty
-	void wakeup(); //Zmienia stan pierwszego procesu na liście WaitingPCB na READY i wywołuje funkcję check () od planisty
+	void block(const std::shared_ptr<PCB>& pcb); //Zmienia stan procesu na WAITING (planista przenosi go do procesów czekających)
+	void wakeup(); //Zmienia stan pierwszego procesu na liście WaitingPCB na READY (planista przenosi go do kolejki gotowych)
 };
 
 #endif //SEMAPHORES_SEMAPHORES_HPP
@@ -167,6 +167,22 @@ void Shell::execute() {
 	else if (parsed[0] == "showpagetable") { showpagetable(); }
 	else if (parsed[0] == "showstack") { showstack(); }
 	else if (parsed[0] == "showframes") { showframes(); }
+	else if (parsed[0] == "showtlb") { showtlb(); }
+	else if (parsed[0] == "settlb") { settlb(); }
+	else if (parsed[0] == "memstat") { memstat(); }
+	else if (parsed[0] == "showshm") { showshm(); }
+	else if (parsed[0] == "swapfile") { swapfile(); }
+	else if (parsed[0] == "zswap") { zswap(); }
+	else if (parsed[0] == "prefetch") { prefetch(); }
+	else if (parsed[0] == "forkmode") { forkmode(); }
+	else if (parsed[0] == "pagetable") { pagetable(); }
+	else if (parsed[0] == "swapper") { swapper(); }
+	else if (parsed[0] == "quota") { quota(); }
+	else if (parsed[0] == "trace") { trace(); }
+	else if (parsed[0] == "swapdisk") { swapdisk(); }
+	else if (parsed[0] == "memheat") { memheat(); }
+	else if (parsed[0] == "schedbench") { schedbench(); }
+	else if (parsed[0] == "sched") { sched(); }
 	else if (parsed[0] == "ver") { ver(); }
 	else if (parsed[0] == "thanks") { thanks(); }
 	else if (parsed[0].empty() || parsed[0] == "go") { go(); }
@@ -181,13 +197,14 @@ void Shell::notRecognized() {
 //Metody interpretera
 void Shell::go() {
 	cout << "Nastepny krok\n";
-	if (!planist.ReadyPCB.empty()) { //Sprawdza czy kolejka procesów READY nie jest pusta (powinien być zawsze conajmniej dummy)
-		if (interpreter.execute_line(planist.ReadyPCB.front()->name) == -1) { //Wykonanie procesu, jeśli false to zakończył działanie
-			const shared_ptr<PCB> tempProc = planist.ReadyPCB.front(); //Tymczasowe ściągnięte PCB
+	const shared_ptr<PCB> tempProc = planist.running_process(); //Proces wybrany przez planistę
+	if (tempProc != nullptr) { //Sprawdza czy kolejka procesów READY nie jest pusta (powinien być zawsze conajmniej dummy)
+		if (interpreter.execute_line(tempProc->name) == -1) { //Wykonanie procesu, jeśli false to zakończył działanie
 			cout << "Proces o nazwie \"" << tempProc->name << "\" zakonczyl swoje dzialanie\n\n";
 			tree.kill(tempProc->name); //zabicie procesu
 		}
-		planist.check(); //aktualizacja planisty (kolejki procesów do wykonania i procesów czekających)
+		planist.check(tempProc); //aktualizacja planisty (czas do końca, kwant czasu) i wybór następnego procesu
+		planist.swapper(); //zawieszenie lub wznowienie procesów przy szamotaniu
 	}
 }
 void Shell::showregs() const {
@@ -255,11 +272,28 @@ Metody pracy krokowej
  showpcblist - Lista PCB wszystkich procesow
  showpcb     - Wyswietla informacje o PCB procesu, np. showpcb [nazwa_procesu]
  showtree    - Wyswietla drzewo procesow
- showmem     - Wyswietlanie zawartosci pamieci
+ showmem     - Wyswietlanie zawartosci pamieci, np. showmem, showmem [poczatek] [bajty] lub showmem diff (tylko zmienione ramki)
  showpagefile  - Wyswietla plik stronicowania
  showpagetable - Wyswietla tablice wymiany stronic np. [nazwa_procesu]
  showstack   - Pokazuje kolejke FIFO wymiany stronic
  showframes  - Pokazuje ramki w pamieci RAM wraz ze szczegolami
+ showtlb     - Pokazuje zawartosc i statystyki bufora TLB
+ settlb      - Zmienia konfiguracje bufora TLB np. settlb [wpisy] [asocjacyjnosc] [flush/asid]
+ memstat     - Statystyki stronicowania, np. memstat lub memstat [nazwa_procesu]
+ showshm     - Pokazuje segmenty pamieci wspoldzielonej
+ swapfile    - Plik stronicowania w pliku na dysku, np. swapfile, swapfile [sciezka] lub swapfile off
+ zswap       - Kompresja pliku stronicowania, np. zswap lub zswap [on/off]
+ prefetch    - Sprowadzanie stronic z wyprzedzeniem, np. prefetch lub prefetch [max_stronic] [wolne_ramki]
+ forkmode    - Tryb forka (rozkaz CP), np. forkmode lub forkmode [cow/copy]
+ pagetable   - Poziomy tablic stronic nowych procesow, np. pagetable lub pagetable [1/2/3]
+ swapper     - Zawieszanie procesow przy szamotaniu, np. swapper, swapper [on/off] lub swapper [prog_zawieszenia] [prog_wznowienia]
+ quota       - Limity ramek i tryb wymiany, np. quota, quota [global/local] lub quota [nazwa_procesu] [min] [max]
+ trace       - Zapis sladu odwolan do pamieci (dla tools/trace_sim), np. trace, trace [sciezka] lub trace off
+ swapdisk    - Obszar wymiany w blokach dysku, np. swapdisk, swapdisk on, swapdisk on [bloki] lub swapdisk off
+ memheat     - Mapa cieplna odwolan do ramek, np. memheat lub memheat reset
+ schedbench  - Pomiar czasu przejscia stanu procesu, np. schedbench lub schedbench [procesy_czekajace]
+ sched       - Polityka planisty, np. sched, sched sjf, sched rr [kwant], sched cfs [kwant] lub sched mlfq [okres_podniesienia] [kwant_poziomu_0] [kwant_poziomu_1] ...
+               oraz waga procesu w CFS, np. sched weight [nazwa_procesu] [waga] (domyslnie 1024)
 
 Metody dodatkowe
  thanks - ;-)
@@ -496,6 +530,7 @@ void Shell::bitvector() const {
 //Metody pamieci
 void Shell::showmem() {
 	if (parsed.size() == 1) { mm.show_memory(); std::cout << "\n"; }
+	else if (parsed.size() == 2 && parsed[1] == "diff") { mm.show_memory_diff(); std::cout << "\n"; }
 	else if (parsed.size() == 3) {
 		const int begin = stoi(parsed[1]);
 		const int bytes = stoi(parsed[2]);
@@ -520,7 +555,7 @@ void Shell::showpagetable() {
 	if (parsed.size() == 2) {
 		if (parsed[1] == "shell") { cout << "Odmowa dostepu!\n"; }
 		else {
-			MemoryManager::show_page_table(tree.find(parsed[1])->pageList);
+			mm.show_page_table(tree.find(parsed[1])->pageTable);
 			std::cout << "\n";
 		}
 	}
@@ -537,6 +572,178 @@ void Shell::showframes() const {
 	else { notRecognized(); }
 }
 
+void Shell::showtlb() const {
+	if (parsed.size() == 1) { mm.show_tlb(); std::cout << "\n"; }
+	else { notRecognized(); }
+}
+
+void Shell::settlb() const {
+	if (parsed.size() == 4 && (parsed[3] == "flush" || parsed[3] == "asid")) {
+		if (mm.set_tlb(stoi(parsed[1]), stoi(parsed[2]), parsed[3] == "asid") == 1) {
+			cout << "Zmieniono konfiguracje bufora TLB\n\n";
+		}
+	}
+	else { notRecognized(); }
+}
+
+void Shell::memstat() const {
+	if (parsed.size() == 1) { mm.show_stats(); std::cout << "\n"; }
+	else if (parsed.size() == 2) {
+		const shared_ptr<PCB> tempProc = tree.find(parsed[1]);
+		if (tempProc != nullptr) { mm.show_stats(tempProc->PID); std::cout << "\n"; }
+		else { cout << "Nie znaleziono procesu o nazwie \"" << parsed[1] << "\"!\n\n"; }
+	}
+	else { notRecognized(); }
+}
+
+void Shell::showshm() const {
+	if (parsed.size() == 1) { mm.show_segments(); std::cout << "\n"; }
+	else { notRecognized(); }
+}
+
+void Shell::swapfile() const {
+	if (parsed.size() == 1) { mm.show_swap_file(); std::cout << "\n"; }
+	else if (parsed.size() == 2) {
+		if (mm.set_swap_file(parsed[1] == "off" ? "" : parsed[1]) == 1) { mm.show_swap_file(); }
+		std::cout << "\n";
+	}
+	else { notRecognized(); }
+}
+
+void Shell::zswap() const {
+	if (parsed.size() == 1) { mm.show_compression(); std::cout << "\n"; }
+	else if (parsed.size() == 2 && (parsed[1] == "on" || parsed[1] == "off")) {
+		if (mm.set_compression(parsed[1] == "on") == 1) { mm.show_compression(); }
+		std::cout << "\n";
+	}
+	else { notRecognized(); }
+}
+
+void Shell::prefetch() const {
+	if (parsed.size() == 1) { mm.show_prefetch(); std::cout << "\n"; }
+	else if (parsed.size() == 3) {
+		if (mm.set_prefetch(stoi(parsed[1]), stoi(parsed[2])) == 1) { mm.show_prefetch(); }
+		std::cout << "\n";
+	}
+	else { notRecognized(); }
+}
+
+void Shell::forkmode() const {
+	if (parsed.size() == 1) { cout << "Tryb forka: " << (mm.get_fork_mode() ? "cow" : "copy") << "\n\n"; }
+	else if (parsed.size() == 2 && (parsed[1] == "cow" || parsed[1] == "copy")) {
+		mm.set_fork_mode(parsed[1] == "cow");
+		cout << "Zmieniono tryb forka na " << parsed[1] << "\n\n";
+	}
+	else { notRecognized(); }
+}
+
+void Shell::pagetable() const {
+	if (parsed.size() == 1) { cout << "Poziomy tablic stronic: " << PageTable::defaultLevels << "\n\n"; }
+	else if (parsed.size() == 2) {
+		if (MemoryManager::set_page_table_levels(stoi(parsed[1])) == 1) {
+			cout << "Nowe procesy beda mialy tablice stronic o " << parsed[1] << " poziomach\n";
+		}
+		std::cout << "\n";
+	}
+	else { notRecognized(); }
+}
+
+void Shell::swapper() const {
+	if (parsed.size() == 1) { planist.show_swapper(); std::cout << "\n"; }
+	else if (parsed.size() == 2 && (parsed[1] == "on" || parsed[1] == "off")) {
+		planist.set_swapper(parsed[1] == "on");
+		planist.show_swapper();
+		std::cout << "\n";
+	}
+	else if (parsed.size() == 3) {
+		if (planist.set_swapper(stod(parsed[1]), stod(parsed[2])) == 1) { planist.show_swapper(); }
+		std::cout << "\n";
+	}
+	else { notRecognized(); }
+}
+
+void Shell::quota() const {
+	if (parsed.size() == 1) { mm.show_frame_quotas(); std::cout << "\n"; }
+	else if (parsed.size() == 2 && (parsed[1] == "global" || parsed[1] == "local")) {
+		mm.set_local_replacement(parsed[1] == "local");
+		cout << "Zmieniono tryb wymiany stronic na " << parsed[1] << "\n\n";
+	}
+	else if (parsed.size() == 4) {
+		const shared_ptr<PCB> process = tree.find(parsed[1]);
+		if (process == nullptr) { cout << "Nie ma takiego procesu!\n\n"; }
+		else {
+			if (mm.set_frame_quota(process->PID, stoi(parsed[2]), stoi(parsed[3])) == 1) { mm.show_frame_quotas(); }
+			std::cout << "\n";
+		}
+	}
+	else { notRecognized(); }
+}
+
+void Shell::trace() const {
+	if (parsed.size() == 1) { mm.show_trace(); std::cout << "\n"; }
+	else if (parsed.size() == 2) {
+		if (mm.set_trace(parsed[1] == "off" ? "" : parsed[1]) == 1) { mm.show_trace(); }
+		std::cout << "\n";
+	}
+	else { notRecognized(); }
+}
+
+void Shell::swapdisk() const {
+	if (parsed.size() == 1) { mm.show_disk_swap(); std::cout << "\n"; }
+	else if ((parsed.size() == 2 || parsed.size() == 3) && (parsed[1] == "on" || parsed[1] == "off")) {
+		if (mm.set_disk_swap(parsed[1] == "on", parsed.size() == 3 ? stoi(parsed[2]) : 8) == 1) { mm.show_disk_swap(); }
+		std::cout << "\n";
+	}
+	else { notRecognized(); }
+}
+
+void Shell::memheat() const {
+	if (parsed.size() == 1) { mm.show_heatmap(); std::cout << "\n"; }
+	else if (parsed.size() == 2 && parsed[1] == "reset") { mm.reset_heatmap(); mm.show_heatmap(); std::cout << "\n"; }
+	else { notRecognized(); }
+}
+
+void Shell::schedbench() const {
+	if (parsed.size() == 1) { Planist::benchmark(100000); std::cout << "\n"; }
+	else if (parsed.size() == 2 && stoi(parsed[1]) >= 0) { Planist::benchmark(stoi(parsed[1])); std::cout << "\n"; }
+	else { notRecognized(); }
+}
+
+void Shell::sched() const {
+	if (parsed.size() == 1) { planist.show_policy(); std::cout << "\n"; }
+	else if (parsed[1] == "sjf" && parsed.size() == 2) {
+		if (planist.set_policy(parsed[1], 0) == 1) { planist.show_policy(); }
+		std::cout << "\n";
+	}
+	else if (parsed[1] == "rr" && parsed.size() <= 3) {
+		if (planist.set_policy(parsed[1], parsed.size() == 3 ? stoi(parsed[2]) : 5) == 1) { planist.show_policy(); }
+		std::cout << "\n";
+	}
+	else if (parsed[1] == "cfs" && parsed.size() <= 3) {
+		if (planist.set_policy(parsed[1], parsed.size() == 3 ? stoi(parsed[2]) : 3) == 1) { planist.show_policy(); }
+		std::cout << "\n";
+	}
+	else if (parsed[1] == "weight" && parsed.size() == 4) {
+		const shared_ptr<PCB> process = tree.find(parsed[2]);
+		if (process == nullptr) { cout << "Nie ma takiego procesu!\n\n"; }
+		else {
+			if (planist.set_weight(process, stoi(parsed[3])) == 1) { cout << "Zmieniono wage procesu \"" << process->name << "\" na " << process->weight << "\n"; }
+			std::cout << "\n";
+		}
+	}
+	else if (parsed[1] == "mlfq") {
+		//Domyślnie 3 poziomy z kwantami 2, 4 i 8 rozkazów, podniesienie priorytetów co 100 rozkazów
+		vector<unsigned int> quanta = { 2, 4, 8 };
+		if (parsed.size() > 3) {
+			quanta.clear();
+			for (size_t i = 3; i < parsed.size(); i++) { quanta.push_back(stoi(parsed[i])); }
+		}
+		if (planist.set_policy(quanta, parsed.size() > 2 ? stoi(parsed[2]) : 100) == 1) { planist.show_policy(); }
+		std::cout << "\n";
+	}
+	else { notRecognized(); }
+}
+
 
 //Easter egg
 void Shell::thanks() {
@@ -67,6 +67,22 @@ private:
 	void showpagetable();		//Wyświetla tablicę wymiany stronnic
 	void showstack() const;		//Pokazuje kolejkę FIFO wymiany stronnic
 	void showframes() const;	//Pokazuje ramki w pamięci RAM wraz ze szczegółami
+	void showtlb() const;		//Pokazuje zawartość i statystyki bufora TLB
+	void settlb() const;		//Zmienia konfigurację bufora TLB
+	void memstat() const;		//Pokazuje statystyki stronicowania (całego systemu lub procesu)
+	void showshm() const;		//Pokazuje segmenty pamięci współdzielonej
+	void swapfile() const;		//Pokazuje lub zmienia miejsce przechowywania pliku stronicowania
+	void zswap() const;			//Pokazuje stan lub włącza/wyłącza kompresję pliku stronicowania
+	void prefetch() const;		//Pokazuje lub zmienia ustawienia sprowadzania stronic z wyprzedzeniem
+	void forkmode() const;		//Pokazuje lub zmienia tryb forka (copy-on-write lub pełna kopia)
+	void pagetable() const;		//Pokazuje lub zmienia ilość poziomów tablic stronic nowych procesów
+	void swapper() const;		//Pokazuje lub zmienia ustawienia swappera (zawieszanie procesów przy szamotaniu)
+	void quota() const;			//Pokazuje lub zmienia limity ramek procesów i tryb wymiany stronic
+	void trace() const;			//Rozpoczyna lub kończy zapis śladu odwołań do pamięci
+	void swapdisk() const;		//Pokazuje stan lub włącza/wyłącza obszar wymiany na dysku systemu plików
+	void memheat() const;		//Pokazuje lub zeruje mapę cieplną odwołań do ramek
+	void schedbench() const;	//Mierzy czas przejścia stanu procesu przy wielu procesach czekających
+	void sched() const;			//Pokazuje lub zmienia politykę planisty (SJF, RR z kwantem czasu, MLFQ, CFS) i wagi procesów
 
 	//Easter Egg
 	static void thanks();
@@ -0,0 +1,56 @@
+// Pomiar czasu usuwania procesu z pamięci (MemoryManager::kill) przy dużej pamięci RAM
+// Tworzy kolejno krótko żyjące procesy, każdy zapisuje wszystkie swoje stronice i jest od razu usuwany
+// Ten sam pomiar wykonywany jest dla małej pamięci RAM - czas kill nie powinien zależeć od ilości ramek
+//
+// Kompilacja (z katalogu głównego, razem z modułami systemu bez main.cpp i Shell.cpp):
+//   cl /std:c++17 /EHsc /O2 tools\kill_benchmark.cpp FileManager.cpp FileManager_private.cpp Interpreter.cpp MemoryManager.cpp Planist.cpp Processes.cpp Semaphores.cpp pipe.cpp winmm.lib
+// Użycie:     kill_benchmark [procesy] [ramki]  (domyślnie 10000 procesów i 65536 ramek, czyli 1 MB RAM)
+#include "../MemoryManager.h"
+#include "../Processes.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+//Rozmiar przestrzeni adresowej procesu testowego [B] - 4 stronice
+static const int PROCESS_SIZE = 64;
+
+//Zwraca łączny czas wywołań kill [ms]
+double measure(int processes, int frames) {
+	MemoryManager memory(frames);
+	double total = 0;
+	for (int i = 0; i < processes; i++) {
+		const shared_ptr<PCB> process = make_shared<PCB>("bench", 1);
+		process->PID = 2 + i;
+		process->pageTable = memory.create_page_list(PROCESS_SIZE, process->PID);
+		//Zapis całej przestrzeni adresowej - wszystkie stronice procesu są w pamięci RAM
+		memory.write(process, 0, string(PROCESS_SIZE, 'x'));
+
+		const auto start = chrono::steady_clock::now();
+		memory.kill(process->PID);
+		total += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	}
+	return total;
+}
+
+int main(int argc, char* argv[]) {
+	const int processes = argc > 1 ? stoi(argv[1]) : 10000;
+	const int frames = argc > 2 ? stoi(argv[2]) : 65536;
+	if (processes <= 0 || frames < PROCESS_SIZE / 16) {
+		cout << "Error: Invalid process or frame count!\n";
+		return 1;
+	}
+
+	const int smallFrames = PROCESS_SIZE / 16 * 4;
+	const double large = measure(processes, frames);
+	const double small = measure(processes, smallFrames);
+
+	cout << fixed << setprecision(3);
+	cout << "kill " << processes << " procesow (" << PROCESS_SIZE / 16 << " stronice w pamieci RAM):\n";
+	cout << " - " << frames << " ramek: " << large << " ms (" << large * 1000 / processes << " us/proces)\n";
+	cout << " - " << smallFrames << " ramek: " << small << " ms (" << small * 1000 / processes << " us/proces)\n";
+	return 0;
+}
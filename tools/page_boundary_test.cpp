@@ -0,0 +1,79 @@
+// Test zapisu i odczytu pamięci na granicach stronic (MemoryManager::write, MemoryManager::read, get_frame)
+// Działa na osobnym MemoryManagerze z 4 ramkami, więc stronice procesu testowego są wymieniane już przy kilku zapisach
+// Wypisuje wynik każdego przypadku, kod wyjścia 1 oznacza, że któryś przypadek się nie powiódł
+//
+// Kompilacja (z katalogu głównego, razem z modułami systemu bez main.cpp i Shell.cpp):
+//   cl /std:c++17 /EHsc tools\page_boundary_test.cpp FileManager.cpp FileManager_private.cpp Interpreter.cpp MemoryManager.cpp Planist.cpp Processes.cpp Semaphores.cpp pipe.cpp winmm.lib
+// Użycie:     page_boundary_test
+#include "../MemoryManager.h"
+#include "../Processes.h"
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+static int failures = 0;
+
+void check(bool passed, const string& name) {
+	cout << (passed ? "OK    " : "BLAD  ") << name << '\n';
+	if (!passed) { failures++; }
+}
+
+//Odczyt fragmentu pamięci procesu ("ERROR", gdy MemoryManager odrzucił odczyt)
+string read_back(MemoryManager& memory, const shared_ptr<PCB>& process, int address, size_t length) {
+	string out(length, '\0');
+	if (memory.read(process, address, &out[0], length) == -1) { return "ERROR"; }
+	return out;
+}
+
+//Czy któraś ze stronic procesu jest w pamięci RAM
+bool any_resident(const MemoryManager& memory, const shared_ptr<PCB>& process) {
+	bool resident = false;
+	memory.page_table(process->pageTable).for_each([&](int, const PageTableData& entry) { resident = resident || entry.bit; });
+	return resident;
+}
+
+int main() {
+	//Proces ze 256 B przestrzeni adresowej (16 stronic, cała tablica płaska) i pamięć RAM o 4 ramkach
+	MemoryManager memory(4);
+	const shared_ptr<PCB> process = make_shared<PCB>("test", 1);
+	process->PID = 2;
+	process->pageTable = memory.create_page_list(256, process->PID);
+	const int last = static_cast<int>(memory.page_table(process->pageTable).size()) * 16 - 1;
+
+	//Zapis przez granicę dwóch stronic (bajty 14-17, stronice 0 i 1)
+	check(memory.write(process, 14, "ABCD") == 1, "zapis przez granice 2 stronic");
+	check(read_back(memory, process, 14, 4) == "ABCD", "odczyt przez granice 2 stronic");
+
+	//Zapis obejmujący trzy stronice (bajty 31-50, stronice 1, 2 i 3) nie może nadpisać poprzedniego zapisu
+	check(memory.write(process, 31, "xyz0123456789012345Q") == 1, "zapis przez 3 stronice");
+	check(read_back(memory, process, 31, 20) == "xyz0123456789012345Q", "odczyt przez 3 stronice");
+	check(read_back(memory, process, 14, 4) == "ABCD", "sasiednie dane po zapisie przez 3 stronice");
+
+	//Ostatni bajt przestrzeni adresowej jest dostępny, bajt za nim już nie
+	check(last == 255, "przestrzen adresowa 256 B");
+	check(memory.write(process, last, "Z") == 1, "zapis ostatniego bajtu");
+	check(read_back(memory, process, last, 1) == "Z", "odczyt ostatniego bajtu");
+	check(memory.write(process, last, "ZZ") == -1, "zapis konczacy sie bajt za koncem odrzucony");
+	check(memory.write(process, last + 1, "Z") == -1, "zapis bajtu za koncem odrzucony");
+	check(read_back(memory, process, last, 2) == "ERROR", "odczyt bajtu za koncem odrzucony");
+	check(read_back(memory, process, last, 1) == "Z", "odrzucony zapis nie zmienia ostatniego bajtu");
+
+	//Zapisy do kolejnych stronic wypychają z 4 ramek wszystkie stronice z danymi testu
+	for (int page = 4; page < 15; page++) { memory.write(process, page * 16, string(16, static_cast<char>('a' + page))); }
+	check(!memory.page_table(process->pageTable).at(0).bit && !memory.page_table(process->pageTable).at(1).bit
+		&& !memory.page_table(process->pageTable).at(15).bit, "stronice z danymi wymienione");
+	check(read_back(memory, process, 14, 4) == "ABCD", "odczyt przez granice 2 stronic po wymianie");
+	check(read_back(memory, process, 31, 20) == "xyz0123456789012345Q", "odczyt przez 3 stronice po wymianie");
+	check(read_back(memory, process, last, 1) == "Z", "odczyt ostatniego bajtu po wymianie");
+	check(read_back(memory, process, 4 * 16, 16) == string(16, 'e'), "odczyt stronicy wypychajacej po wymianie");
+
+	//Zawieszenie procesu zwalnia wszystkie jego ramki - dane wracają z pliku stronicowania
+	memory.swap_out(process->PID);
+	check(!any_resident(memory, process), "zawieszenie zwalnia ramki");
+	check(read_back(memory, process, 31, 20) == "xyz0123456789012345Q", "odczyt przez 3 stronice po zawieszeniu");
+
+	cout << (failures == 0 ? "Wszystkie przypadki zaliczone\n" : "Niezaliczone przypadki: " + to_string(failures) + "\n");
+	return failures == 0 ? 0 : 1;
+}
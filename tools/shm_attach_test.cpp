@@ -0,0 +1,69 @@
+// Test dołączania segmentu pamięci współdzielonej na końcu przestrzeni adresowej (MemoryManager::shm_attach)
+// Segment, który nie mieści się w przestrzeni adresowej procesu, musi zostać odrzucony bez zmiany procesu i segmentu
+// Wypisuje wynik każdego przypadku, kod wyjścia 1 oznacza, że któryś przypadek się nie powiódł
+//
+// Kompilacja (z katalogu głównego, razem z modułami systemu bez main.cpp i Shell.cpp):
+//   cl /std:c++17 /EHsc tools\shm_attach_test.cpp FileManager.cpp FileManager_private.cpp Interpreter.cpp MemoryManager.cpp Planist.cpp Processes.cpp Semaphores.cpp pipe.cpp winmm.lib
+// Użycie:     shm_attach_test
+#include "../MemoryManager.h"
+#include "../Processes.h"
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+static int failures = 0;
+
+void check(bool passed, const string& name) {
+	cout << (passed ? "OK    " : "BLAD  ") << name << '\n';
+	if (!passed) { failures++; }
+}
+
+shared_ptr<PCB> make_process(MemoryManager& memory, int PID, int size) {
+	const shared_ptr<PCB> process = make_shared<PCB>("test" + to_string(PID), 1);
+	process->PID = PID;
+	process->pageTable = memory.create_page_list(size, PID);
+	process->size = static_cast<unsigned int>(memory.page_table(process->pageTable).size()) * 16;
+	return process;
+}
+
+//Przypadki dla tablicy stronic o danej ilości poziomów
+void test_levels(int levels) {
+	const string prefix = to_string(levels) + " poz.: ";
+	PageTable::defaultLevels = levels;
+	MemoryManager memory(16);
+	const int limit = static_cast<int>(PageTable::address_limit(levels));
+
+	//Proces zajmujący całą przestrzeń adresową - segment 32 B już się nie zmieści
+	const shared_ptr<PCB> full = make_process(memory, 2, limit);
+	check(memory.shm_get("seg", 32) == 1, prefix + "utworzenie segmentu");
+	check(memory.shm_attach(full, "seg") == -1, prefix + "dolaczenie do pelnego procesu odrzucone");
+	check(full->size == static_cast<unsigned int>(limit), prefix + "rozmiar procesu bez zmian");
+	check(memory.page_table(full->pageTable).size() == static_cast<size_t>(limit / 16), prefix + "tablica stronic bez zmian");
+
+	//Segment mieszczący się dokładnie na końcu przestrzeni adresowej
+	const shared_ptr<PCB> fitting = make_process(memory, 3, limit - 32);
+	const int base = memory.shm_attach(fitting, "seg");
+	check(base == limit - 32, prefix + "dolaczenie na koncu przestrzeni adresowej");
+	check(memory.write(fitting, base, string(32, 's')) == 1, prefix + "zapis calego segmentu");
+	check(memory.write(fitting, base + 32, "s") == -1, prefix + "zapis za segmentem odrzucony");
+
+	//Odrzucony proces nie trzyma segmentu - po odłączeniu jedynego procesu segment jest usuwany
+	memory.shm_detach_all(full->PID);
+	memory.shm_detach_all(fitting->PID);
+	check(memory.shm_get("seg", 32) == 1, prefix + "segment usuniety po odlaczeniu");
+
+	memory.kill(full->PID);
+	memory.kill(fitting->PID);
+}
+
+int main() {
+	const int levels = PageTable::defaultLevels;
+	test_levels(1);
+	test_levels(2);
+	PageTable::defaultLevels = levels;
+
+	cout << (failures == 0 ? "Wszystkie przypadki zaliczone\n" : "Niezaliczone przypadki: " + to_string(failures) + "\n");
+	return failures == 0 ? 0 : 1;
+}
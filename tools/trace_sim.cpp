@@ -0,0 +1,184 @@
+// Symulator algorytmów wymiany stronic dla śladu odwołań do pamięci zapisanego przez MemoryManager (polecenie shella "trace")
+// Odtwarza ten sam ślad dla kolejnych ilości ramek algorytmami FIFO, LRU, CLOCK i optymalnym (Belady) i wypisuje krzywe błędów stronicy
+// Stronica identyfikowana jest parą (PID, numer stronicy) - współdzielenie stronic między procesami nie jest odtwarzane
+//
+// Kompilacja: g++ -std=c++17 -O2 tools/trace_sim.cpp -o trace_sim
+// Użycie:     trace_sim plik_sladu [min_ramek] [max_ramek]  (domyślnie od 1 do dwukrotności ilości ramek z nagłówka śladu)
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <list>
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <limits>
+
+using namespace std;
+
+//------------- Rekord śladu (taki sam jak MemoryManager::TraceRecord) -------------
+struct TraceRecord {
+	uint32_t PID; //Numer procesu
+	uint32_t access; //Numer stronicy przesunięty o 1 bit, najmłodszy bit - zapis (1) lub odczyt (0)
+};
+
+//Klucz stronicy w symulacji: PID w starszych 32 bitach, numer stronicy w młodszych
+typedef uint64_t PageKey;
+
+//Wczytuje ślad z pliku
+/* path - ścieżka do pliku śladu
+ * frames - ilość ramek systemu, w którym ślad został zapisany (z nagłówka)
+ * @return bool False, gdy pliku nie ma albo nie jest śladem
+ */
+bool load_trace(const string& path, vector<PageKey>& trace, uint32_t& frames) {
+	ifstream file(path, ios::binary);
+	uint32_t header[4];
+	if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] != 0x52545853 || header[1] != 1) { return false; }
+	frames = header[2];
+
+	TraceRecord record;
+	while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+		trace.push_back(static_cast<PageKey>(record.PID) << 32 | record.access >> 1);
+	}
+	return true;
+}
+
+//------------- FIFO - ofiarą jest stronica najdłużej przebywająca w pamięci -------------
+unsigned long long simulate_fifo(const vector<PageKey>& trace, size_t frames) {
+	unsigned long long faults = 0;
+	unordered_set<PageKey> resident;
+	deque<PageKey> queue;
+
+	for (const PageKey page : trace) {
+		if (resident.count(page) != 0) continue;
+		faults++;
+		if (resident.size() == frames) {
+			resident.erase(queue.front());
+			queue.pop_front();
+		}
+		resident.insert(page);
+		queue.push_back(page);
+	}
+	return faults;
+}
+
+//------------- LRU - ofiarą jest stronica najdawniej użyta -------------
+unsigned long long simulate_lru(const vector<PageKey>& trace, size_t frames) {
+	unsigned long long faults = 0;
+	list<PageKey> stack; //Od najdawniej do ostatnio użytej
+	unordered_map<PageKey, list<PageKey>::iterator> resident;
+
+	for (const PageKey page : trace) {
+		const auto found = resident.find(page);
+		if (found != resident.end()) {
+			stack.splice(stack.end(), stack, found->second);
+			continue;
+		}
+		faults++;
+		if (resident.size() == frames) {
+			resident.erase(stack.front());
+			stack.pop_front();
+		}
+		resident[page] = stack.insert(stack.end(), page);
+	}
+	return faults;
+}
+
+//------------- CLOCK - druga szansa dla stronic z ustawionym bitem odwołania -------------
+unsigned long long simulate_clock(const vector<PageKey>& trace, size_t frames) {
+	unsigned long long faults = 0;
+	vector<PageKey> frame;
+	vector<bool> referenced;
+	unordered_map<PageKey, size_t> resident; //Stronica -> ramka
+	size_t hand = 0;
+
+	for (const PageKey page : trace) {
+		const auto found = resident.find(page);
+		if (found != resident.end()) {
+			referenced[found->second] = true;
+			continue;
+		}
+		faults++;
+		if (frame.size() < frames) {
+			resident[page] = frame.size();
+			frame.push_back(page);
+			referenced.push_back(true);
+			continue;
+		}
+		while (referenced[hand]) {
+			referenced[hand] = false;
+			hand = (hand + 1) % frames;
+		}
+		resident.erase(frame[hand]);
+		resident[page] = hand;
+		frame[hand] = page;
+		referenced[hand] = true;
+		hand = (hand + 1) % frames;
+	}
+	return faults;
+}
+
+//------------- OPT (Belady) - ofiarą jest stronica, do której najdłużej nie będzie odwołania -------------
+unsigned long long simulate_opt(const vector<PageKey>& trace, const vector<size_t>& nextUse, size_t frames) {
+	unsigned long long faults = 0;
+	set<pair<size_t, PageKey>> byNextUse; //Stronice w pamięci uporządkowane według następnego odwołania
+	unordered_map<PageKey, size_t> resident; //Stronica -> następne odwołanie
+
+	for (size_t i = 0; i < trace.size(); i++) {
+		const PageKey page = trace[i];
+		const auto found = resident.find(page);
+		if (found != resident.end()) {
+			byNextUse.erase(make_pair(found->second, page));
+		}
+		else {
+			faults++;
+			if (resident.size() == frames) {
+				const auto victim = prev(byNextUse.end());
+				resident.erase(victim->second);
+				byNextUse.erase(victim);
+			}
+		}
+		resident[page] = nextUse[i];
+		byNextUse.emplace(nextUse[i], page);
+	}
+	return faults;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc < 2) {
+		cout << "Uzycie: " << argv[0] << " plik_sladu [min_ramek] [max_ramek]\n";
+		return 1;
+	}
+
+	vector<PageKey> trace;
+	uint32_t recordedFrames = 0;
+	if (!load_trace(argv[1], trace, recordedFrames)) {
+		cout << "Error: \"" << argv[1] << "\" is not a memory trace!\n";
+		return 1;
+	}
+	const size_t minFrames = argc > 2 ? stoul(argv[2]) : 1;
+	const size_t maxFrames = argc > 3 ? stoul(argv[3]) : 2 * static_cast<size_t>(recordedFrames);
+	if (minFrames == 0 || maxFrames < minFrames) {
+		cout << "Error: Invalid frame range!\n";
+		return 1;
+	}
+
+	//Następne odwołanie do tej samej stronicy dla każdego odwołania (liczone raz, od końca śladu)
+	vector<size_t> nextUse(trace.size());
+	unordered_map<PageKey, size_t> lastSeen;
+	for (size_t i = trace.size(); i-- > 0;) {
+		const auto seen = lastSeen.find(trace[i]);
+		nextUse[i] = seen == lastSeen.end() ? numeric_limits<size_t>::max() : seen->second;
+		lastSeen[trace[i]] = i;
+	}
+
+	cout << "Trace: " << trace.size() << " accesses, " << lastSeen.size() << " distinct pages, recorded with " << recordedFrames << " frames\n";
+	cout << "FRAMES\tFIFO\tLRU\tCLOCK\tOPT\n";
+	for (size_t frames = minFrames; frames <= maxFrames; frames++) {
+		cout << frames << "\t" << simulate_fifo(trace, frames) << "\t" << simulate_lru(trace, frames) << "\t"
+			<< simulate_clock(trace, frames) << "\t" << simulate_opt(trace, nextUse, frames) << "\n";
+	}
+	return 0;
+}